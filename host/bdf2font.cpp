@@ -0,0 +1,192 @@
+/*
+ Converts a BDF font into the proportional font format of ss_oled
+ (see ss_oled.h, oledDrawPropString()) and writes it as a C header.
+
+ Each character gets a cell of its advance width (DWIDTH) and the
+ height of the font (FONT_ASCENT + FONT_DESCENT, at most 32 rows);
+ its columns are stored bit-packed or run-length coded, whichever
+ is shorter.
+
+ Usage: bdf2font font.bdf name [first [last]] > font.h
+ The characters first ... last (default 32 ... 126) are converted,
+ characters missing in the BDF file get a width of 0.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+
+#define MAX_HEIGHT 32
+#define MAX_WIDTH  127
+#define RLE        0x80
+
+struct Glyph {
+    int width = 0;                      // advance
+    std::vector<std::vector<bool>> px;  // [column][row] of the cell
+};
+
+struct Font {
+    int ascent = -1, descent = -1;
+    int bbx_h = 0, bbx_y = 0;           // FONTBOUNDINGBOX, if the properties are missing
+    std::map<int, Glyph> glyphs;
+    int height() const { return ascent + descent; }
+};
+
+static bool fail(const char *what, const char *path) {
+    fprintf(stderr, "%s: %s\n", path, what);
+    return false;
+}
+
+static bool load_bdf(const char *path, Font &font) {
+    std::ifstream in(path);
+    if (!in)
+        return fail("cannot read", path);
+    std::string line, key;
+    while (std::getline(in, line)) {
+        std::istringstream ls(line);
+        ls >> key;
+        if (key == "FONTBOUNDINGBOX") {
+            int w, x;
+            ls >> w >> font.bbx_h >> x >> font.bbx_y;
+        }
+        else if (key == "FONT_ASCENT")  ls >> font.ascent;
+        else if (key == "FONT_DESCENT") ls >> font.descent;
+        else if (key == "STARTCHAR") {
+            if (font.ascent < 0 || font.descent < 0) {
+                font.ascent  = font.bbx_h + font.bbx_y;
+                font.descent = -font.bbx_y;
+            }
+            if (font.height() < 1 || font.height() > MAX_HEIGHT)
+                return fail("font height must be 1 ... 32 pixels", path);
+            int encoding = -1, advance = 0, w = 0, h = 0, xo = 0, yo = 0;
+            while (std::getline(in, line)) {
+                std::istringstream cs(line);
+                cs >> key;
+                if (key == "ENCODING")    cs >> encoding;
+                else if (key == "DWIDTH") cs >> advance;
+                else if (key == "BBX")    cs >> w >> h >> xo >> yo;
+                else if (key == "BITMAP" || key == "ENDCHAR") break;
+            }
+            if (advance > MAX_WIDTH)
+                return fail("characters must be at most 127 pixels wide", path);
+            Glyph glyph;
+            glyph.width = advance;
+            glyph.px.assign(advance, std::vector<bool>(font.height(), false));
+            // rows of the bitmap, top to bottom; the bottom row is yo below the baseline
+            for (int row = 0; key == "BITMAP" && std::getline(in, line); row++) {
+                if (line.compare(0, 7, "ENDCHAR") == 0)
+                    break;
+                int y = font.ascent - (yo + h) + row;
+                for (int bx = 0; bx < w; bx++) {
+                    size_t digit = bx / 4;
+                    if (digit >= line.size())
+                        break;
+                    int nibble = (int) strtol(line.substr(digit, 1).c_str(), NULL, 16);
+                    int x = xo + bx;
+                    if ((nibble & (8 >> (bx & 3))) && x >= 0 && x < advance && y >= 0 && y < font.height())
+                        glyph.px[x][y] = true;
+                }
+            }
+            if (encoding >= 0)
+                font.glyphs[encoding] = glyph;
+        }
+    }
+    if (font.glyphs.empty())
+        return fail("no characters", path);
+    return true;
+}
+
+// the pixels of a glyph, column after column, top to bottom
+static std::vector<bool> pixels(const Glyph &glyph) {
+    std::vector<bool> p;
+    for (const auto &column : glyph.px)
+        p.insert(p.end(), column.begin(), column.end());
+    return p;
+}
+
+static std::vector<uint8_t> pack(const std::vector<bool> &p) {
+    std::vector<uint8_t> out((p.size() + 7) / 8, 0);
+    for (size_t i = 0; i < p.size(); i++)
+        if (p[i])
+            out[i / 8] |= 1 << (i % 8);
+    return out;
+}
+
+static std::vector<uint8_t> runs(const std::vector<bool> &p) {
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i < p.size();) {
+        size_t n = 1;
+        while (i + n < p.size() && p[i + n] == p[i] && n < 128)
+            n++;
+        out.push_back((p[i] ? 0x80 : 0) | (uint8_t) (n - 1));
+        i += n;
+    }
+    return out;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: bdf2font font.bdf name [first [last]] > font.h\n");
+        return 1;
+    }
+    int first = argc > 3 ? atoi(argv[3]) : 32;
+    int last  = argc > 4 ? atoi(argv[4]) : 126;
+    if (first < 0 || last > 255 || first > last) {
+        fprintf(stderr, "invalid character range\n");
+        return 1;
+    }
+    Font font;
+    if (!load_bdf(argv[1], font))
+        return 1;
+
+    std::vector<uint8_t> table, data;
+    table.push_back((uint8_t) font.height());
+    table.push_back((uint8_t) first);
+    table.push_back((uint8_t) last);
+    table.push_back((uint8_t) font.ascent);
+    int coded = 0, widest = 0;
+    for (int c = first; c <= last; c++) {
+        auto it = font.glyphs.find(c);
+        Glyph glyph = (it != font.glyphs.end()) ? it->second : Glyph();
+        std::vector<bool> p = pixels(glyph);
+        std::vector<uint8_t> packed = pack(p), rle = runs(p);
+        bool use_rle = rle.size() < packed.size();
+        const std::vector<uint8_t> &columns = use_rle ? rle : packed;
+        if (data.size() > 0xffff) {
+            fprintf(stderr, "font too large\n");
+            return 1;
+        }
+        table.push_back((uint8_t) (glyph.width | (use_rle ? RLE : 0)));
+        table.push_back((uint8_t) (data.size() & 0xff));
+        table.push_back((uint8_t) (data.size() >> 8));
+        data.insert(data.end(), columns.begin(), columns.end());
+        coded += use_rle;
+        if (glyph.width > widest)
+            widest = glyph.width;
+    }
+    table.insert(table.end(), data.begin(), data.end());
+
+    int count = last - first + 1;
+    int fixed = count * widest * ((font.height() + 7) / 8);
+    const char *base = strrchr(argv[1], '/');
+    printf("// %s converted by host/bdf2font: proportional font for\n", base ? base + 1 : argv[1]);
+    printf("// oledDrawPropString(), height %d, characters %d ... %d, %zu bytes\n",
+           font.height(), first, last, table.size());
+    printf("// (%d characters run-length coded; %d bytes as fixed %dx%d cells)\n",
+           coded, fixed, widest, ((font.height() + 7) / 8) * 8);
+    printf("#pragma once\n#include <stdint.h>\n\n");
+    printf("static const uint8_t %s[] = {\n", argv[2]);
+    for (size_t i = 0; i < table.size(); i++)
+        printf("0x%02x,%s", table[i], (i % 16 == 15 || i + 1 == table.size()) ? "\n" : "");
+    printf("};\n");
+    fprintf(stderr, "%s: height %d, %d characters, %zu bytes\n", argv[2], font.height(), count, table.size());
+    return 0;
+}
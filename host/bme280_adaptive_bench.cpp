@@ -0,0 +1,171 @@
+/*
+ Runs BME280Adaptive against the register-level model of the sensor
+ (bme280_model.hpp) with the sensor noise of the datasheet, and
+ compares it with fixed oversampling: transactions and bytes, the
+ conversion time and the charge the sensor draws per measurement, and
+ the RMS deviation of the results from the model input. For the
+ adaptive runs it also prints every change of the levels it chose.
+
+ Usage: bme280_adaptive_bench [values.csv]
+ Without a file the input is two hours, measured every 10 s: flat
+ values, a step, a slow ramp (weather) and a fast one (a ride in a lift).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "bme280_model.hpp"
+#include "bme280_adaptive.hpp"
+
+#define CS_PIN      PICO_DEFAULT_SPI_CSN_PIN
+#define SPI_FREQ    (500 * 1000)
+#define INTERVAL_MS 10000
+#define DURATION_S  (2 * 3600)
+#define ROUNDS      (DURATION_S * 1000 / INTERVAL_MS)
+#define MAX_CHANGES 64
+
+// the input of every run, from time 0
+static BME280Model source;
+
+static void load_input(const char *csv_path) {
+    if (csv_path) {
+        if (!source.load_csv(csv_path))
+            printf("cannot read %s\n", csv_path);
+        return;
+    }
+    // time in s, temperature, pressure in hPa, humidity
+    static const double trace[][4] = {
+        {    0, 20.0, 1013.25, 50.0 },
+        { 1200, 20.0, 1013.25, 50.0 },
+        { 1201, 22.0, 1013.25, 45.0 },  // step: a window opened
+        { 2400, 22.0, 1013.25, 45.0 },
+        { 3600, 25.0, 1007.25, 55.0 },  // slow ramp: 0.1 hPa per interval
+        { 4800, 25.0, 1007.25, 55.0 },
+        { 4860, 25.0, 1002.25, 55.0 },  // fast ramp: 0.8 hPa per interval
+        { DURATION_S, 25.0, 1002.25, 55.0 },
+    };
+    for (const auto &s : trace)
+        source.add_sample((uint64_t) s[0] * 1000000ull, s[1], s[2] * 100.0, s[3]);
+}
+
+// the input, sampled every second, from now on; the time of the
+// simulation goes on from one run to the next
+static void setup_input(BME280Model &model) {
+    uint64_t start_us = time_us_64();
+    for (uint64_t s = 0; s <= DURATION_S; s++) {
+        double temperature, pressure, humidity;
+        source.input_at(s * 1000000ull, temperature, pressure, humidity);
+        model.add_sample(start_us + s * 1000000ull, temperature, pressure, humidity);
+    }
+    model.set_noise(true);
+}
+
+// charge the sensor draws in a forced conversion in uC: typical time of
+// the phases (datasheet, appendix B) at the current of each phase
+// (datasheet, table 1: 350 uA temperature, 714 uA pressure, 340 uA humidity)
+static double conversion_charge_uc(uint osrs_t, uint osrs_p, uint osrs_h) {
+    double t = 1.0 + 2.0 * BME280::oversampling_factor(osrs_t);
+    double p = osrs_p ? 2.0 * BME280::oversampling_factor(osrs_p) + 0.5 : 0.0;
+    double h = osrs_h ? 2.0 * BME280::oversampling_factor(osrs_h) + 0.5 : 0.0;
+    return 0.350 * t + 0.714 * p + 0.340 * h;
+}
+
+static const char *filter_name(BME280::FILTER filter) {
+    static const char *names[] = { "off", "2", "4", "8", "16" };
+    return (filter <= BME280::FILTER_16) ? names[filter] : "?";
+}
+
+// fixed oversampling if adapt is 0, else BME280Adaptive with a budget
+// of budget_us (0 = unlimited)
+static void run(const char *name, BME280::OVERSAMPLING osrs_t, BME280::OVERSAMPLING osrs_p,
+                BME280::OVERSAMPLING osrs_h, bool adapt, uint32_t budget_us = 0) {
+    BME280Model model;
+    setup_input(model);
+    sim_attach_spi(spi0, CS_PIN, &model);
+    BME280 sensor(0, PICO_DEFAULT_SPI_RX_PIN, PICO_DEFAULT_SPI_TX_PIN, PICO_DEFAULT_SPI_SCK_PIN,
+                  CS_PIN, SPI_FREQ, BME280::MODE_FORCED);
+    sensor.set_oversampling(osrs_t, osrs_p, osrs_h);
+    sensor.set_filter(BME280::FILTER_OFF);
+    BME280Adaptive adaptive(sensor);
+    adaptive.set_budget_us(budget_us);
+    model.clear_stats();
+
+    char changes[MAX_CHANGES][40];
+    uint n_changes = 0;
+    uint last[4] = { 0, 0, 0, 0 };
+    double square[3] = { 0, 0, 0 };
+    double conversion_us = 0, charge_uc = 0;
+    uint32_t failures = 0, n = 0;
+    absolute_time_t next = get_absolute_time();
+    for (int i = 0; i < ROUNDS; i++) {
+        uint t = sensor.get_oversampling_t(), p = sensor.get_oversampling_p(), h = sensor.get_oversampling_h();
+        uint now[4] = { t, p, h, (uint) sensor.get_filter() };
+        if (adapt && memcmp(now, last, sizeof(now)) && n_changes < MAX_CHANGES)
+            snprintf(changes[n_changes++], sizeof(changes[0]), "%6.1f min  x%-2u x%-2u x%-2u %-3s",
+                     i * INTERVAL_MS / 60000.0, BME280::oversampling_factor(t), BME280::oversampling_factor(p),
+                     BME280::oversampling_factor(h), filter_name(sensor.get_filter()));
+        memcpy(last, now, sizeof(now));
+        conversion_us += BME280::conversion_time_typ_us(t, p, h);
+        charge_uc     += conversion_charge_uc(t, p, h);
+        BME280::Measurement_t values = adapt ? adaptive.measure() : sensor.measure();
+        if (sensor.get_last_error() != PICO_OK) {
+            failures++;
+        }
+        else {
+            double temperature, pressure, humidity;
+            model.input_at(sensor.get_sample_time_us(), temperature, pressure, humidity);
+            square[0] += pow(values.temperature - temperature, 2);
+            square[1] += pow(values.pressure * 100.0 - pressure, 2);
+            square[2] += pow(values.humidity - humidity, 2);
+            n++;
+        }
+        next += INTERVAL_MS * 1000ull;
+        sleep_until(next);
+    }
+    const BME280Model::Stats &s = model.get_stats();
+    printf("%-26s %5.2f %5.2f %6.2f %6.2f   %6.4f %5.2f %6.4f",
+           name, (double) s.transactions / ROUNDS, (double) s.bytes / ROUNDS, conversion_us / ROUNDS / 1000.0,
+           charge_uc / ROUNDS, sqrt(square[0] / n), sqrt(square[1] / n), sqrt(square[2] / n));
+    if (adapt)    printf("  %u reconfigurations", adaptive.get_reconfigurations());
+    if (failures) printf("  %u timeouts", failures);
+    printf("\n");
+
+    if (adapt) {
+        static const char *channels[] = { "temperature", "pressure", "humidity" };
+        printf("    share of the time at x1/x2/x4/x8/x16:");
+        for (uint c = 0; c < BME280Adaptive::NUM_CHANNELS; c++) {
+            uint64_t total = 0;
+            for (uint l = 0; l < BME280Adaptive::NUM_LEVELS; l++)
+                total += adaptive.get_time_us((BME280Adaptive::CHANNEL) c, l);
+            printf("%s %s", c ? "," : "", channels[c]);
+            for (uint l = 0; l < BME280Adaptive::NUM_LEVELS; l++)
+                printf("%s%.0f%%", l ? "/" : " ",
+                       total ? 100.0 * adaptive.get_time_us((BME280Adaptive::CHANNEL) c, l) / total : 0.0);
+        }
+        printf("\n    from the time on: T P H filter\n");
+        for (uint l = 0; l < n_changes; l++)
+            printf("    %s%s", changes[l], (l % 4 == 3 || l + 1 == n_changes) ? "\n" : "  |");
+    }
+    sim_detach_spi(&model);
+}
+
+int main(int argc, char **argv) {
+    load_input((argc > 1) ? argv[1] : NULL);
+    spi_init(spi0, SPI_FREQ);
+
+    printf("%d measurements every %d s, SPI at %d kHz, per measurement:\n",
+           ROUNDS, INTERVAL_MS / 1000, SPI_FREQ / 1000);
+    printf("%-26s %5s %5s %6s %6s   %6s %5s %6s\n", "", "trans", "bytes", "conv", "charge",
+           "RMS C", "Pa", "%RH");
+    printf("%-26s %5s %5s %6s %6s\n", "", "", "", "ms", "uC");
+    run("fixed x1 x1 x1", BME280::OVERSAMPLING_X1, BME280::OVERSAMPLING_X1, BME280::OVERSAMPLING_X1, false);
+    run("fixed x4 x4 x1 (default)", BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X1, false);
+    run("fixed x16 x16 x16", BME280::OVERSAMPLING_X16, BME280::OVERSAMPLING_X16, BME280::OVERSAMPLING_X16, false);
+    run("adaptive", BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X1, true);
+    run("adaptive, budget 20 ms", BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X4, BME280::OVERSAMPLING_X1,
+        true, 20000);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ Dispatch of the batch compensation to the instruction set
+ and to threads.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "bme280_batch.hpp"
+
+// below this number of samples per thread, starting threads costs more than it saves
+#define MIN_SAMPLES_PER_THREAD (64 * 1024)
+
+typedef void (*Kernel)(const BME280Calibration &, const int32_t *, const int32_t *, const int32_t *,
+                       int32_t *, uint32_t *, uint32_t *, size_t);
+
+#ifdef BME280_BATCH_X86
+void bme280_compensate_sse41(const BME280Calibration &, const int32_t *, const int32_t *, const int32_t *,
+                             int32_t *, uint32_t *, uint32_t *, size_t);
+void bme280_compensate_avx2(const BME280Calibration &, const int32_t *, const int32_t *, const int32_t *,
+                            int32_t *, uint32_t *, uint32_t *, size_t);
+#endif
+
+static void compensate_scalar(const BME280Calibration &calib,
+                              const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                              int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                              size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t t_fine;
+        temperature[i] = bme280_compensate_temperature(calib, adc_T[i], t_fine);
+        pressure[i]    = bme280_compensate_pressure(calib, adc_P[i], t_fine);
+        humidity[i]    = bme280_compensate_humidity(calib, adc_H[i], t_fine);
+    }
+}
+
+bool bme280_batch_supported(BME280BatchISA isa) {
+    switch (isa) {
+#ifdef BME280_BATCH_X86
+        case BME280_BATCH_SSE41: return __builtin_cpu_supports("sse4.1");
+        case BME280_BATCH_AVX2:  return __builtin_cpu_supports("avx2");
+#else
+        case BME280_BATCH_SSE41:
+        case BME280_BATCH_AVX2:  return false;
+#endif
+        default:                 return true;
+    }
+}
+
+BME280BatchISA bme280_batch_isa() {
+    if (bme280_batch_supported(BME280_BATCH_AVX2))  return BME280_BATCH_AVX2;
+    if (bme280_batch_supported(BME280_BATCH_SSE41)) return BME280_BATCH_SSE41;
+    return BME280_BATCH_SCALAR;
+}
+
+static Kernel kernel_of(BME280BatchISA isa) {
+    if (isa == BME280_BATCH_AUTO || !bme280_batch_supported(isa))
+        isa = bme280_batch_isa();
+    switch (isa) {
+#ifdef BME280_BATCH_X86
+        case BME280_BATCH_AVX2:  return bme280_compensate_avx2;
+        case BME280_BATCH_SSE41: return bme280_compensate_sse41;
+#endif
+        default:                 return compensate_scalar;
+    }
+}
+
+void bme280_compensate_batch(const BME280Calibration &calib,
+                             const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                             int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                             size_t n, unsigned threads, BME280BatchISA isa) {
+    Kernel kernel = kernel_of(isa);
+
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > n / MIN_SAMPLES_PER_THREAD)
+        threads = std::max<size_t>(1, n / MIN_SAMPLES_PER_THREAD);
+    if (threads == 1) {
+        kernel(calib, adc_T, adc_P, adc_H, temperature, pressure, humidity, n);
+        return;
+    }
+
+    // contiguous chunks, a multiple of 64 samples each so that
+    // no two threads write to the same cache line
+    size_t chunk = (n / threads + 63) & ~(size_t) 63;
+    std::vector<std::thread> workers;
+    for (size_t first = 0; first < n; first += chunk) {
+        size_t count = std::min(chunk, n - first);
+        workers.emplace_back(kernel, std::cref(calib),
+                             adc_T + first, adc_P + first, adc_H + first,
+                             temperature + first, pressure + first, humidity + first, count);
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
@@ -0,0 +1,39 @@
+/*
+ Batch compensation of recorded BME280 adc values on a host.
+
+ The arrays hold one channel each (structure of arrays). The results
+ are bit-exact with the 32 bit integer routines in
+ src/bme280_compensation.hpp, which the BME280 class uses as well.
+ Depending on the CPU the batch is processed with SSE4.1 (4 samples
+ per instruction) or AVX2 (8 samples), large batches are split
+ over several threads.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include "bme280_compensation.hpp"
+
+enum BME280BatchISA {
+    BME280_BATCH_AUTO,      // best instruction set of this CPU
+    BME280_BATCH_SCALAR,
+    BME280_BATCH_SSE41,
+    BME280_BATCH_AVX2
+};
+
+// instruction set BME280_BATCH_AUTO stands for
+BME280BatchISA bme280_batch_isa();
+// false if the CPU or the build does not support the instruction set
+bool bme280_batch_supported(BME280BatchISA isa);
+
+// adc_T, adc_P, adc_H: 20, 20 and 16 bit adc values of n samples
+// temperature: 0.01 degrees celsius, pressure: Pa, humidity: 1/1024 %RH
+// threads: 0 uses all cores, 1 stays in the calling thread
+void bme280_compensate_batch(const BME280Calibration &calib,
+                             const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                             int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                             size_t n, unsigned threads = 0,
+                             BME280BatchISA isa = BME280_BATCH_AUTO);
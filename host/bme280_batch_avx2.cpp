@@ -0,0 +1,55 @@
+/*
+ AVX2 instance of the batch compensation: 8 samples per instruction.
+ Compiled with -mavx2 (see CMakeLists.txt).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <immintrin.h>
+#include "bme280_batch_kernel.hpp"
+
+struct AVX2 {
+    typedef __m256i V;
+    enum { LANES = 8 };
+
+    static V load(const int32_t *p)     { return _mm256_loadu_si256((const __m256i *) p); }
+    static void store(int32_t *p, V a)  { _mm256_storeu_si256((__m256i *) p, a); }
+    static V set1(int32_t x)            { return _mm256_set1_epi32(x); }
+    static V add(V a, V b)              { return _mm256_add_epi32(a, b); }
+    static V sub(V a, V b)              { return _mm256_sub_epi32(a, b); }
+    static V mul(V a, V b)              { return _mm256_mullo_epi32(a, b); }
+    static V min(V a, V b)              { return _mm256_min_epi32(a, b); }
+    static V max(V a, V b)              { return _mm256_max_epi32(a, b); }
+    static V cmpeq(V a, V b)            { return _mm256_cmpeq_epi32(a, b); }
+    static V andnot(V mask, V a)        { return _mm256_andnot_si256(mask, a); }
+    static V blend(V a, V b, V mask)    { return _mm256_blendv_epi8(a, b, mask); }
+    template <int N> static V sra(V a)  { return _mm256_srai_epi32(a, N); }
+    template <int N> static V srl(V a)  { return _mm256_srli_epi32(a, N); }
+    template <int N> static V sll(V a)  { return _mm256_slli_epi32(a, N); }
+
+    // unsigned 32 bit values <-> double, by way of the signed range
+    static __m256d to_double(__m128i a) {
+        a = _mm_xor_si128(a, _mm_set1_epi32(0x80000000));
+        return _mm256_add_pd(_mm256_cvtepi32_pd(a), _mm256_set1_pd(2147483648.0));
+    }
+    static __m128i from_double(__m256d d) {
+        __m128i a = _mm256_cvttpd_epi32(_mm256_sub_pd(_mm256_floor_pd(d), _mm256_set1_pd(2147483648.0)));
+        return _mm_xor_si128(a, _mm_set1_epi32(0x80000000));
+    }
+    // unsigned a / b
+    static V divu(V a, V b) {
+        __m128i lo = from_double(_mm256_div_pd(to_double(_mm256_castsi256_si128(a)),
+                                               to_double(_mm256_castsi256_si128(b))));
+        __m128i hi = from_double(_mm256_div_pd(to_double(_mm256_extracti128_si256(a, 1)),
+                                               to_double(_mm256_extracti128_si256(b, 1))));
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    }
+};
+
+void bme280_compensate_avx2(const BME280Calibration &calib,
+                            const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                            int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                            size_t n) {
+    bme280_compensate_lanes<AVX2>(calib, adc_T, adc_P, adc_H, temperature, pressure, humidity, n);
+}
@@ -0,0 +1,94 @@
+/*
+ Vectorised form of the BME280 compensation routines, written once
+ against a small set of lane operations. bme280_batch_sse41.cpp and
+ bme280_batch_avx2.cpp instantiate it for 4 and 8 lanes of int32_t.
+
+ Every step maps to the scalar code in src/bme280_compensation.hpp:
+ products are 32 bit (mullo), >> of signed values is arithmetic,
+ >> of unsigned values logical. The only division in the pressure
+ path is done in double precision: both operands are below 2^32,
+ so the truncated double quotient equals the integer quotient.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include "bme280_compensation.hpp"
+
+template <class S>
+static void bme280_compensate_lanes(const BME280Calibration &c,
+                                    const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                                    int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                                    size_t n) {
+    typedef typename S::V V;
+
+    const V T1 = S::set1(c.dig_T1), T2 = S::set1(c.dig_T2), T3 = S::set1(c.dig_T3);
+    const V P1 = S::set1(c.dig_P1), P2 = S::set1(c.dig_P2), P3 = S::set1(c.dig_P3);
+    const V P4 = S::set1(c.dig_P4), P5 = S::set1(c.dig_P5), P6 = S::set1(c.dig_P6);
+    const V P7 = S::set1(c.dig_P7), P8 = S::set1(c.dig_P8), P9 = S::set1(c.dig_P9);
+    const V H1 = S::set1(c.dig_H1), H2 = S::set1(c.dig_H2), H3 = S::set1(c.dig_H3);
+    const V H4 = S::set1(c.dig_H4), H5 = S::set1(c.dig_H5), H6 = S::set1(c.dig_H6);
+    const V zero = S::set1(0);
+
+    size_t i = 0;
+    for (; i + S::LANES <= n; i += S::LANES) {
+        // temperature
+        V adc = S::load(adc_T + i);
+        V var1 = S::template sra<11>(S::mul(S::sub(S::template sra<3>(adc), S::template sll<1>(T1)), T2));
+        V d    = S::sub(S::template sra<4>(adc), T1);
+        V var2 = S::template sra<14>(S::mul(S::template sra<12>(S::mul(d, d)), T3));
+        V t_fine = S::add(var1, var2);
+        S::store(temperature + i,
+                 S::template sra<8>(S::add(S::mul(t_fine, S::set1(5)), S::set1(128))));
+
+        // pressure
+        var1 = S::sub(S::template sra<1>(t_fine), S::set1(64000));
+        V q  = S::template sra<11>(S::mul(S::template sra<2>(var1), S::template sra<2>(var1)));
+        var2 = S::mul(q, P6);
+        var2 = S::add(var2, S::template sll<1>(S::mul(var1, P5)));
+        var2 = S::add(S::template sra<2>(var2), S::template sll<16>(P4));
+        q    = S::template sra<13>(S::mul(S::template sra<2>(var1), S::template sra<2>(var1)));
+        var1 = S::template sra<18>(S::add(S::template sra<3>(S::mul(P3, q)),
+                                          S::template sra<1>(S::mul(P2, var1))));
+        var1 = S::template sra<15>(S::mul(S::add(S::set1(32768), var1), P1));
+        V invalid = S::cmpeq(var1, zero);
+
+        adc = S::load(adc_P + i);
+        V p = S::mul(S::sub(S::sub(S::set1(1048576), adc), S::template sra<12>(var2)), S::set1(3125));
+        // p < 0x80000000 ? (p << 1) / var1 : (p / var1) * 2
+        V high = S::template sra<31>(p);
+        p = S::blend(S::divu(S::template sll<1>(p), var1),
+                     S::template sll<1>(S::divu(p, var1)), high);
+
+        q    = S::template srl<3>(p);
+        var1 = S::template sra<12>(S::mul(P9, S::template srl<13>(S::mul(q, q))));
+        var2 = S::template sra<13>(S::mul(S::template srl<2>(p), P8));
+        p    = S::add(p, S::template sra<4>(S::add(S::add(var1, var2), P7)));
+        S::store((int32_t *) pressure + i, S::andnot(invalid, p));
+
+        // humidity
+        adc = S::load(adc_H + i);
+        V v = S::sub(t_fine, S::set1(76800));
+        V a = S::template sra<15>(S::add(S::sub(S::sub(S::template sll<14>(adc), S::template sll<20>(H4)),
+                                                S::mul(H5, v)),
+                                         S::set1(16384)));
+        V b = S::template sra<10>(S::mul(S::template sra<10>(S::mul(v, H6)),
+                                         S::add(S::template sra<11>(S::mul(v, H3)), S::set1(32768))));
+        b = S::template sra<14>(S::add(S::mul(S::add(b, S::set1(2097152)), H2), S::set1(8192)));
+        v = S::mul(a, b);
+        q = S::template sra<15>(v);
+        v = S::sub(v, S::template sra<4>(S::mul(S::template sra<7>(S::mul(q, q)), H1)));
+        v = S::min(S::max(v, zero), S::set1(419430400));
+        S::store((int32_t *) humidity + i, S::template sra<12>(v));
+    }
+
+    for (; i < n; i++) {
+        int32_t t_fine;
+        temperature[i] = bme280_compensate_temperature(c, adc_T[i], t_fine);
+        pressure[i]    = bme280_compensate_pressure(c, adc_P[i], t_fine);
+        humidity[i]    = bme280_compensate_humidity(c, adc_H[i], t_fine);
+    }
+}
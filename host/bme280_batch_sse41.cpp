@@ -0,0 +1,54 @@
+/*
+ SSE4.1 instance of the batch compensation: 4 samples per instruction.
+ Compiled with -msse4.1 (see CMakeLists.txt).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <smmintrin.h>
+#include "bme280_batch_kernel.hpp"
+
+struct SSE41 {
+    typedef __m128i V;
+    enum { LANES = 4 };
+
+    static V load(const int32_t *p)     { return _mm_loadu_si128((const __m128i *) p); }
+    static void store(int32_t *p, V a)  { _mm_storeu_si128((__m128i *) p, a); }
+    static V set1(int32_t x)            { return _mm_set1_epi32(x); }
+    static V add(V a, V b)              { return _mm_add_epi32(a, b); }
+    static V sub(V a, V b)              { return _mm_sub_epi32(a, b); }
+    static V mul(V a, V b)              { return _mm_mullo_epi32(a, b); }
+    static V min(V a, V b)              { return _mm_min_epi32(a, b); }
+    static V max(V a, V b)              { return _mm_max_epi32(a, b); }
+    static V cmpeq(V a, V b)            { return _mm_cmpeq_epi32(a, b); }
+    static V andnot(V mask, V a)        { return _mm_andnot_si128(mask, a); }
+    static V blend(V a, V b, V mask)    { return _mm_blendv_epi8(a, b, mask); }
+    template <int N> static V sra(V a)  { return _mm_srai_epi32(a, N); }
+    template <int N> static V srl(V a)  { return _mm_srli_epi32(a, N); }
+    template <int N> static V sll(V a)  { return _mm_slli_epi32(a, N); }
+
+    // unsigned 32 bit values <-> double, by way of the signed range
+    static __m128d to_double(V a) {
+        a = _mm_xor_si128(a, _mm_set1_epi32(0x80000000));
+        return _mm_add_pd(_mm_cvtepi32_pd(a), _mm_set1_pd(2147483648.0));
+    }
+    static V from_double(__m128d d) {
+        V a = _mm_cvttpd_epi32(_mm_sub_pd(_mm_floor_pd(d), _mm_set1_pd(2147483648.0)));
+        return _mm_xor_si128(a, _mm_set1_epi32(0x80000000));
+    }
+    // unsigned a / b
+    static V divu(V a, V b) {
+        V lo = from_double(_mm_div_pd(to_double(a), to_double(b)));
+        V hi = from_double(_mm_div_pd(to_double(_mm_unpackhi_epi64(a, a)),
+                                      to_double(_mm_unpackhi_epi64(b, b))));
+        return _mm_unpacklo_epi64(lo, hi);
+    }
+};
+
+void bme280_compensate_sse41(const BME280Calibration &calib,
+                             const int32_t *adc_T, const int32_t *adc_P, const int32_t *adc_H,
+                             int32_t *temperature, uint32_t *pressure, uint32_t *humidity,
+                             size_t n) {
+    bme280_compensate_lanes<SSE41>(calib, adc_T, adc_P, adc_H, temperature, pressure, humidity, n);
+}
@@ -0,0 +1,131 @@
+/*
+ Checks BME280History against the register-level model of the sensor
+ (bme280_model.hpp): samples from BME280::measure_raw() at odd
+ intervals fill a history several times over, and the records read
+ back must equal the compensated samples and carry their times within
+ the documented 1 s. Also covered: the cap of a gap at 255 s, the
+ sample of a failed measure_raw(), and reads past the newest record.
+
+ Usage: bme280_history_check
+ Prints each check and exits with 1 if one of them fails.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "bme280_model.hpp"
+#include "bme280_history.hpp"
+
+#define CS_PIN      PICO_DEFAULT_SPI_CSN_PIN
+#define SPI_FREQ    (500 * 1000)
+#define HISTORY     16
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+    printf("%-62s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok)
+        failures++;
+}
+
+// appends one sample per interval_us to history and keeps every
+// sample with its time in samples[0 ... n - 1]
+static void record(BME280 &sensor, BME280History<HISTORY> &history, uint64_t interval_us,
+                   int n, BME280::RawSample_t *samples) {
+    absolute_time_t next = get_absolute_time();
+    for (int i = 0; i < n; i++) {
+        next += interval_us;
+        sleep_until(next);
+        samples[i] = sensor.measure_raw();
+        history.append(samples[i]);
+    }
+}
+
+// the history holds the last HISTORY of the n samples: values equal to
+// their compensation, times within max_error_us
+static bool matches(BME280 &sensor, BME280History<HISTORY> &history,
+                    const BME280::RawSample_t *samples, int n, double &max_error_us) {
+    bool ok = (history.size() == HISTORY);
+    max_error_us = 0;
+    for (uint i = 0; ok && i < HISTORY; i++) {
+        const BME280::RawSample_t &s = samples[n - HISTORY + i];
+        BME280::MeasurementFixed_t expected = sensor.compensate(BME280::adc_temperature(s.data),
+                                                                BME280::adc_pressure(s.data),
+                                                                BME280::adc_humidity(s.data));
+        const BME280::MeasurementFixed_t &got = history.get(i);
+        ok = got.valid == BME280::VALID_ALL && got.temperature == expected.temperature &&
+             got.pressure == expected.pressure && got.humidity == expected.humidity;
+        max_error_us = fmax(max_error_us, fabs((double) history.get_time_us(i) - (double) s.time_us));
+    }
+    return ok;
+}
+
+int main() {
+    BME280Model model;
+    model.set_noise(true); // every sample differs
+    for (uint64_t s = 0; s <= 6 * 3600; s += 60)
+        model.add_sample(s * 1000000ull, 15.0 + 5.0 * sin(s / 3000.0), 101325.0 + 300.0 * cos(s / 2000.0),
+                         50.0 + 10.0 * sin(s / 5000.0));
+    spi_init(spi0, SPI_FREQ);
+    sim_attach_spi(spi0, CS_PIN, &model);
+    BME280 sensor(0, PICO_DEFAULT_SPI_RX_PIN, PICO_DEFAULT_SPI_TX_PIN, PICO_DEFAULT_SPI_SCK_PIN,
+                  CS_PIN, SPI_FREQ, BME280::MODE_FORCED);
+    char what[80];
+    double error_us;
+
+    // odd interval, the ring wraps around 2.5 times
+    static BME280::RawSample_t samples[200];
+    BME280History<HISTORY> history(sensor);
+    record(sensor, history, 20500000, 40, samples);
+    bool ok = matches(sensor, history, samples, 40, error_us);
+    snprintf(what, sizeof(what), "40 samples every 20.5 s: values, times (error %.2f s)", error_us / 1e6);
+    check(ok && error_us < 1e6, what);
+
+    // the rounding must not add up over many records
+    record(sensor, history, 20500000, 200, samples);
+    ok = matches(sensor, history, samples, 200, error_us);
+    snprintf(what, sizeof(what), "200 more samples: values, times (error %.2f s)", error_us / 1e6);
+    check(ok && error_us < 1e6, what);
+
+    record(sensor, history, 7300000, 50, samples);
+    ok = matches(sensor, history, samples, 50, error_us);
+    snprintf(what, sizeof(what), "50 samples every 7.3 s: values, times (error %.2f s)", error_us / 1e6);
+    check(ok && error_us < 1e6, what);
+
+    // a gap of 400 s is kept as 255 s: the newer records keep their
+    // times, the older ones appear 145 s late
+    record(sensor, history, 10000000, HISTORY / 2, samples);
+    record(sensor, history, 400000000, 1, &samples[HISTORY / 2]);
+    record(sensor, history, 10000000, HISTORY / 2 - 1, &samples[HISTORY / 2 + 1]);
+    ok = matches(sensor, history, samples, HISTORY, error_us);
+    double newer = 0, older = 0;
+    for (uint i = 0; i < HISTORY; i++) {
+        double e = (double) history.get_time_us(i) - (double) samples[i].time_us;
+        if (i < HISTORY / 2) older = fmax(older, fabs(e - 145e6));
+        else                 newer = fmax(newer, fabs(e));
+    }
+    snprintf(what, sizeof(what), "gap of 400 s: newer records (error %.2f s)", newer / 1e6);
+    check(ok && newer < 1e6, what);
+    snprintf(what, sizeof(what), "gap of 400 s: older records 145 s late (error %.2f s)", older / 1e6);
+    check(older < 1e6, what);
+
+    // measure_raw() returns a zeroed sample on a timeout
+    BME280::RawSample_t failed;
+    memset(&failed, 0, sizeof(failed));
+    uint64_t newest_us = history.get_time_us(HISTORY - 1);
+    check(!history.append(failed) && history.size() == HISTORY &&
+          history.get_time_us(HISTORY - 1) == newest_us, "sample of a failed measure_raw() rejected");
+    BME280::RawSample_t early = samples[HISTORY - 2];
+    check(!history.append(early) && history.get_time_us(HISTORY - 1) == newest_us,
+          "sample older than the newest record rejected");
+
+    check(history.get(HISTORY).valid == 0 && history.get_time_us(HISTORY) == 0,
+          "index past the newest record: valid 0, time 0");
+
+    sim_detach_spi(&model);
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
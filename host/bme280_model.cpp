@@ -0,0 +1,399 @@
+/*
+ Register-level model of a BME280, see bme280_model.hpp.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <algorithm>
+#include "bme280_model.hpp"
+
+// registers (datasheet, section 5.3)
+#define REG_CALIB_00    0x88
+#define REG_CHIP_ID     0xD0
+#define REG_RESET       0xE0
+#define REG_CALIB_26    0xE1
+#define REG_CTRL_HUM    0xF2
+#define REG_STATUS      0xF3
+#define REG_CTRL_MEAS   0xF4
+#define REG_CONFIG      0xF5
+#define REG_PRESS_MSB   0xF7
+#define REG_HUM_LSB     0xFE
+
+#define STATUS_MEASURING    0x08
+#define STATUS_IM_UPDATE    0x01
+#define RESET_COMMAND       0xB6
+#define MODE_SLEEP          0x0
+#define MODE_NORMAL         0x3
+
+// time from power-on until the sensor answers
+#define STARTUP_TIME_US     2000
+
+// t_sb of the config register in microseconds
+static const uint32_t standby_us[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 10000, 20000 };
+
+// RMS noise with x1 oversampling: degrees celsius, Pa, %RH
+static const double NOISE_T = 0.005, NOISE_P = 3.3, NOISE_H = 0.07;
+
+static uint32_t factor(uint osrs) {
+    return (osrs == 0) ? 0 : ((osrs >= 5) ? 16 : (1u << (osrs - 1)));
+}
+
+const BME280Calibration &BME280Model::default_calibration() {
+    static const BME280Calibration sensor = {
+        27504, 26435, -1000,
+        36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+        75, 0, 30, 362, 339, 0
+    };
+    return sensor;
+}
+
+BME280Model::BME280Model(const BME280Calibration &calib) {
+    this->calib     = calib;
+    this->raw_trace = false;
+    this->noise     = false;
+    this->spread    = 1.0f;
+    this->selected  = false;
+    clear_stats();
+    reset();
+}
+
+void BME280Model::reset() {
+    memset(regs, 0, sizeof(regs));
+    regs[REG_CHIP_ID] = CHIP_ID;
+    encode_calibration();
+    // reset values of the data registers
+    static const uint8_t data_reset[8] = { 0x80, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0x00 };
+    memcpy(&regs[REG_PRESS_MSB], data_reset, sizeof(data_reset));
+    ready_time    = time_us_64() + STARTUP_TIME_US;
+    measuring     = false;
+    osrs_t = osrs_p = osrs_h = 0;
+    filter_primed = false;
+}
+
+void BME280Model::clear_stats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void BME280Model::set_noise(bool on, uint32_t seed) {
+    noise = on;
+    rng.seed(seed);
+}
+
+// little endian register pairs, H4 and H5 are 12 bit values sharing 0xE5
+void BME280Model::encode_calibration() {
+    const uint16_t words[12] = {
+        calib.dig_T1, (uint16_t) calib.dig_T2, (uint16_t) calib.dig_T3,
+        calib.dig_P1, (uint16_t) calib.dig_P2, (uint16_t) calib.dig_P3,
+        (uint16_t) calib.dig_P4, (uint16_t) calib.dig_P5, (uint16_t) calib.dig_P6,
+        (uint16_t) calib.dig_P7, (uint16_t) calib.dig_P8, (uint16_t) calib.dig_P9
+    };
+    for (int i = 0; i < 12; i++) {
+        regs[REG_CALIB_00 + 2 * i]     = words[i] & 0xff;
+        regs[REG_CALIB_00 + 2 * i + 1] = words[i] >> 8;
+    }
+    regs[0xA1] = calib.dig_H1;
+    uint8_t *h = &regs[REG_CALIB_26];
+    h[0] = calib.dig_H2 & 0xff;
+    h[1] = (uint16_t) calib.dig_H2 >> 8;
+    h[2] = calib.dig_H3;
+    h[3] = (calib.dig_H4 >> 4) & 0xff;
+    h[4] = (calib.dig_H4 & 0xf) | ((calib.dig_H5 & 0xf) << 4);
+    h[5] = (calib.dig_H5 >> 4) & 0xff;
+    h[6] = (uint8_t) calib.dig_H6;
+}
+
+// input
+
+void BME280Model::add_sample(uint64_t time_us, double temperature, double pressure, double humidity) {
+    if (raw_trace)
+        clear_trace();
+    trace.push_back({ time_us, temperature, pressure, humidity });
+}
+
+void BME280Model::add_raw_sample(uint64_t time_us, int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+    if (!raw_trace)
+        clear_trace();
+    raw_trace = true;
+    trace.push_back({ time_us, (double) adc_T, (double) adc_P, (double) adc_H });
+}
+
+void BME280Model::clear_trace() {
+    trace.clear();
+    raw_trace = false;
+}
+
+bool BME280Model::load_csv(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    clear_trace();
+    char line[256];
+    double t, temperature, pressure, humidity;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%lf,%lf,%lf,%lf", &t, &temperature, &pressure, &humidity) == 4)
+            add_sample((uint64_t) (t * 1e6), temperature, pressure * 100.0, humidity);
+    }
+    fclose(f);
+    return true;
+}
+
+bool BME280Model::load_raw_trace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+    clear_trace();
+    char line[256];
+    double t;
+    int32_t adc_T, adc_P, adc_H;
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "%lf,%d,%d,%d", &t, &adc_T, &adc_P, &adc_H) == 4)
+            add_raw_sample((uint64_t) (t * 1e6), adc_T, adc_P, adc_H);
+    }
+    fclose(f);
+    raw_trace = true;
+    return true;
+}
+
+BME280Model::Sample BME280Model::values_at(uint64_t time) const {
+    if (trace.empty())
+        return { time, 20.0, 101325.0, 50.0 };
+    auto next = std::upper_bound(trace.begin(), trace.end(), time,
+                                 [](uint64_t t, const Sample &s) { return t < s.time_us; });
+    if (next == trace.begin())
+        return trace.front();
+    if (next == trace.end() || raw_trace)
+        return *(next - 1);
+    const Sample &a = *(next - 1), &b = *next;
+    double w = (double) (time - a.time_us) / (double) (b.time_us - a.time_us);
+    return { time, a.temperature + w * (b.temperature - a.temperature),
+                   a.pressure    + w * (b.pressure    - a.pressure),
+                   a.humidity    + w * (b.humidity    - a.humidity) };
+}
+
+void BME280Model::input_at(uint64_t time_us, double &temperature, double &pressure, double &humidity) const {
+    Sample s = values_at(time_us);
+    temperature = s.temperature;
+    pressure    = s.pressure;
+    humidity    = s.humidity;
+}
+
+// inverse compensation: the adc value whose compensated value is
+// closest to target, by bisection over the monotonic compensation
+template <class F>
+static int32_t inverse(F f, int64_t target, int32_t max_adc, bool increasing) {
+    int32_t lo = 0, hi = max_adc;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        int64_t v = f(mid);
+        if (increasing ? v >= target : v <= target) hi = mid;
+        else                                        lo = mid + 1;
+    }
+    if (lo > 0 && llabs(f(lo - 1) - target) < llabs(f(lo) - target))
+        lo--;
+    return lo;
+}
+
+int32_t BME280Model::inverse_temperature(double temperature, int32_t &t_fine) const {
+    int32_t adc = inverse([this](int32_t adc) { int32_t t; return (int64_t) bme280_compensate_temperature(calib, adc, t); },
+                          llround(temperature * 100.0), 0xfffff, true);
+    bme280_compensate_temperature(calib, adc, t_fine);
+    return adc;
+}
+
+int32_t BME280Model::inverse_pressure(double pressure, int32_t t_fine) const {
+    return inverse([this, t_fine](int32_t adc) { return (int64_t) bme280_compensate_pressure(calib, adc, t_fine); },
+                   llround(pressure), 0xfffff, false);
+}
+
+int32_t BME280Model::inverse_humidity(double humidity, int32_t t_fine) const {
+    return inverse([this, t_fine](int32_t adc) { return (int64_t) bme280_compensate_humidity(calib, adc, t_fine); },
+                   llround(humidity * 1024.0), 0xffff, true);
+}
+
+// conversion
+
+uint32_t BME280Model::conversion_time_us(bool maximum) const {
+    uint32_t t = factor(osrs_t), p = factor(osrs_p), h = factor(osrs_h);
+    if (maximum)
+        return 1250 + 2300 * t + (p ? 2300 * p + 575 : 0) + (h ? 2300 * h + 575 : 0);
+    return 1000 + 2000 * t + (p ? 2000 * p + 500 : 0) + (h ? 2000 * h + 500 : 0);
+}
+
+void BME280Model::start_conversion(uint64_t time) {
+    osrs_t = (regs[REG_CTRL_MEAS] >> 5) & 0x7;
+    osrs_p = (regs[REG_CTRL_MEAS] >> 2) & 0x7;
+    uint32_t typ = conversion_time_us(false);
+    uint32_t max = conversion_time_us(true);
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    start_time = time;
+    end_time   = time + typ + (uint64_t) (spread * u * (max - typ));
+    measuring  = true;
+}
+
+void BME280Model::complete_conversion() {
+    Sample s = values_at(end_time);
+    int32_t adc_T, adc_P, adc_H;
+    if (raw_trace) {
+        adc_T = (int32_t) s.temperature;
+        adc_P = (int32_t) s.pressure;
+        adc_H = (int32_t) s.humidity;
+    }
+    else {
+        if (noise) {
+            std::normal_distribution<double> gauss(0.0, 1.0);
+            // averaging N samples reduces the noise by sqrt(N)
+            if (osrs_t) s.temperature += gauss(rng) * NOISE_T / sqrt(factor(osrs_t));
+            if (osrs_p) s.pressure    += gauss(rng) * NOISE_P / sqrt(factor(osrs_p));
+            if (osrs_h) s.humidity    += gauss(rng) * NOISE_H / sqrt(factor(osrs_h));
+        }
+        int32_t t_fine;
+        adc_T = inverse_temperature(s.temperature, t_fine);
+        adc_P = inverse_pressure(s.pressure, t_fine);
+        adc_H = inverse_humidity(std::min(100.0, std::max(0.0, s.humidity)), t_fine);
+    }
+
+    // without the IIR filter, temperature and pressure have 16 bit
+    // with x1 oversampling and one bit more per doubling
+    uint filter = (regs[REG_CONFIG] >> 2) & 0x7;
+    if (filter == 0) {
+        if (osrs_t) adc_T &= ~((1 << (5 - std::min(osrs_t, (uint8_t) 5))) - 1);
+        if (osrs_p) adc_P &= ~((1 << (5 - std::min(osrs_p, (uint8_t) 5))) - 1);
+    }
+    // data_filtered = (data_filtered_old * (c - 1) + data_adc) / c
+    int32_t c = 1 << std::min(filter, 4u);
+    if (!filter_primed) {
+        filtered_T = adc_T;
+        filtered_P = adc_P;
+        filter_primed = true;
+    }
+    if (osrs_t) filtered_T = (filtered_T * (c - 1) + adc_T) / c;
+    if (osrs_p) filtered_P = (filtered_P * (c - 1) + adc_P) / c;
+    adc_T = osrs_t ? filtered_T : 0x80000;
+    adc_P = osrs_p ? filtered_P : 0x80000;
+    adc_H = osrs_h ? adc_H : 0x8000;
+
+    uint8_t *d = &regs[REG_PRESS_MSB];
+    d[0] = adc_P >> 12; d[1] = adc_P >> 4; d[2] = (adc_P & 0xf) << 4;
+    d[3] = adc_T >> 12; d[4] = adc_T >> 4; d[5] = (adc_T & 0xf) << 4;
+    d[6] = adc_H >> 8;  d[7] = adc_H;
+    stats.conversions++;
+}
+
+// completes the conversions that ended up to now; in normal mode
+// the next one starts after the standby time
+void BME280Model::update(uint64_t now) {
+    while (measuring && end_time <= now) {
+        complete_conversion();
+        if ((regs[REG_CTRL_MEAS] & 0x3) != MODE_NORMAL) {
+            regs[REG_CTRL_MEAS] &= ~0x3; // forced mode returns to sleep
+            measuring = false;
+            break;
+        }
+        uint64_t period = (end_time - start_time) + standby_us[regs[REG_CONFIG] >> 5];
+        uint64_t next = end_time + standby_us[regs[REG_CONFIG] >> 5];
+        // after a long gap only the last cycles matter
+        if (now > next + 2 * period)
+            next += ((now - next) / period - 1) * period;
+        start_conversion(next);
+    }
+}
+
+void BME280Model::write(uint8_t reg, uint8_t value) {
+    uint64_t now = time_us_64();
+    switch (reg) {
+        case REG_RESET:
+            if (value == RESET_COMMAND)
+                reset();
+            break;
+        case REG_CTRL_HUM: // becomes effective with the next ctrl_meas write
+            regs[REG_CTRL_HUM] = value & 0x7;
+            break;
+        case REG_CTRL_MEAS:
+            regs[REG_CTRL_MEAS] = value;
+            osrs_h = regs[REG_CTRL_HUM];
+            if ((value & 0x3) == MODE_SLEEP) {
+                if (measuring && start_time > now) // normal mode standby
+                    measuring = false;
+            }
+            else
+            if (!measuring)
+                start_conversion(now);
+            break;
+        case REG_CONFIG: // writes in normal mode may be ignored (datasheet, 5.4.6)
+            if ((regs[REG_CTRL_MEAS] & 0x3) == MODE_NORMAL)
+                stats.ignored_writes++;
+            else
+                regs[REG_CONFIG] = value & ~0x2;
+            break;
+        default:            // read-only
+            break;
+    }
+}
+
+uint8_t BME280Model::peek(uint8_t reg) {
+    update(time_us_64());
+    if (reg == REG_STATUS) {
+        uint64_t now = time_us_64();
+        return ((measuring && now >= start_time) ? STATUS_MEASURING : 0)
+             | ((now < ready_time) ? STATUS_IM_UPDATE : 0);
+    }
+    return regs[reg];
+}
+
+// SPI: the first byte holds the register address in bits 6..0 and
+// the read flag in bit 7. Reads continue with auto-incremented
+// addresses, writes continue with (register, value) pairs.
+
+void BME280Model::select() {
+    uint64_t now = time_us_64();
+    update(now);
+    selected    = true;
+    first_byte  = true;
+    select_time = now;
+    stats.transactions++;
+    // status and data registers stay consistent during a burst read
+    regs[REG_STATUS] = peek(REG_STATUS);
+    memcpy(latched, &regs[REG_PRESS_MSB], sizeof(latched));
+}
+
+uint8_t BME280Model::transfer(uint8_t mosi) {
+    stats.bytes++;
+    if (!selected || time_us_64() < ready_time)
+        return 0xff;
+    if (first_byte) {
+        first_byte = false;
+        reading    = (mosi & 0x80) != 0;
+        address    = mosi | 0x80;
+        if (reading && address == REG_STATUS)
+            stats.status_reads++;
+        return 0xff;
+    }
+    if (reading) {
+        stats.register_reads++;
+        uint8_t reg = address++;
+        if (reg >= REG_PRESS_MSB && reg <= REG_HUM_LSB)
+            return latched[reg - REG_PRESS_MSB];
+        return regs[reg];
+    }
+    // write: address and value alternate
+    if (address == 0) {
+        address = mosi | 0x80;
+        return 0xff;
+    }
+    stats.register_writes++;
+    write(address, mosi);
+    address = 0;
+    return 0xff;
+}
+
+void BME280Model::deselect() {
+    if (!selected)
+        return;
+    selected = false;
+    stats.bus_time_us += time_us_64() - select_time;
+}
@@ -0,0 +1,136 @@
+/*
+ Register-level model of a BME280 on a simulated SPI bus (see
+ sim/pico_sim.hpp), so the BME280 class runs on a host:
+
+   BME280Model model;
+   model.load_csv("weather.csv");
+   sim_attach_spi(spi0, PICO_DEFAULT_SPI_CSN_PIN, &model);
+   BME280 sensor(0, PICO_DEFAULT_SPI_RX_PIN, ..., BME280::MODE_FORCED);
+
+ The model has the register file of the datasheet (section 5): chip id,
+ calibration, ctrl_hum, ctrl_meas, config, status and data registers,
+ with auto-increment on reads and (register, value) pairs on writes.
+ Conversions take the time the datasheet gives for the oversampling
+ (between the typical and the maximum time), the measuring bit of the
+ status register is set meanwhile. Forced and normal mode, the IIR
+ filter, the resolution per oversampling and skipped channels behave
+ like the sensor. Data registers are latched per transaction (shadowing).
+
+ The values converted come from a trace of physical values, which are
+ turned into adc values with the inverse of the compensation, or from
+ a trace of recorded adc values. The model counts the transactions and
+ bytes on the bus, so the efficiency of the driver can be measured.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <random>
+#include <vector>
+#include "pico_sim.hpp"
+#include "bme280_compensation.hpp"
+
+class BME280Model : public SimSPIDevice {
+public:
+    static const uint8_t CHIP_ID = 0x60;
+
+    // bus usage since construction or clear_stats()
+    struct Stats {
+        uint32_t transactions;      // chip select low phases
+        uint32_t bytes;             // bytes clocked, including register addresses
+        uint32_t register_reads;    // bytes read
+        uint32_t register_writes;   // (register, value) pairs written
+        uint32_t ignored_writes;    // config written in normal mode, dropped by the sensor
+        uint32_t status_reads;      // transactions that read 0xF3
+        uint32_t conversions;
+        uint64_t bus_time_us;       // time with chip select low
+    };
+
+    // calibration of the model; the default is the one of a real sensor
+    explicit BME280Model(const BME280Calibration &calib = default_calibration());
+    static const BME280Calibration &default_calibration();
+    const BME280Calibration &get_calibration() const { return calib; }
+
+    // Input. Values are interpolated linearly between the samples of a
+    // physical trace and held between the samples of a raw trace; the
+    // first and last sample hold before and after the trace.
+    // temperature in degrees celsius, pressure in Pa, humidity in %RH
+    void add_sample(uint64_t time_us, double temperature, double pressure, double humidity);
+    // adc values as read from the data registers
+    void add_raw_sample(uint64_t time_us, int32_t adc_T, int32_t adc_P, int32_t adc_H);
+    // CSV lines "time_s,temperature_C,pressure_hPa,humidity_%RH";
+    // lines that do not start with a number (headers, comments) are skipped.
+    // Replaces the current trace, returns false if the file cannot be read.
+    bool load_csv(const char *path);
+    // CSV lines "time_s,adc_T,adc_P,adc_H", e.g. from BME280::measure_raw()
+    bool load_raw_trace(const char *path);
+    void clear_trace();
+    // values converted at time_us: physical values, or adc values of a raw trace
+    void input_at(uint64_t time_us, double &temperature, double &pressure, double &humidity) const;
+    bool has_raw_trace() const { return raw_trace; }
+
+    // RMS noise of the sensor with x1 oversampling, reduced by the
+    // oversampling factor (datasheet, sections 1 and 3.5); off by default
+    void set_noise(bool on, uint32_t seed = 280);
+    // conversion time: typical time + spread * (maximum - typical),
+    // randomly for each conversion; 0 for the typical time, default 1
+    void set_conversion_spread(float spread) { this->spread = spread; }
+
+    // power-on reset; the sensor answers 2 ms later
+    void reset();
+
+    const Stats &get_stats() const { return stats; }
+    void clear_stats();
+    // current register contents, without side effects
+    uint8_t peek(uint8_t reg);
+
+    // SimSPIDevice
+    void    select() override;
+    uint8_t transfer(uint8_t mosi) override;
+    void    deselect() override;
+
+private:
+    struct Sample {
+        uint64_t time_us;
+        double   temperature, pressure, humidity;  // raw trace: adc values
+    };
+
+    BME280Calibration   calib;
+    uint8_t             regs[256];
+    std::vector<Sample> trace;
+    bool                raw_trace;
+    bool                noise;
+    std::mt19937        rng;
+    float               spread;
+    Stats               stats;
+
+    // SPI transaction
+    bool        selected;
+    bool        reading;
+    bool        first_byte;
+    uint8_t     address;
+    uint64_t    select_time;
+    uint8_t     latched[8];     // data registers at the start of the transaction
+
+    // conversion
+    uint64_t    ready_time;     // end of the power-on reset (im_update)
+    bool        measuring;
+    uint64_t    start_time, end_time;
+    uint8_t     osrs_t, osrs_p, osrs_h;   // of the running conversion
+    int32_t     filtered_T, filtered_P;   // IIR filter state
+    bool        filter_primed;
+
+    void        write(uint8_t reg, uint8_t value);
+    void        start_conversion(uint64_t time);
+    void        complete_conversion();
+    void        update(uint64_t now);
+    uint32_t    conversion_time_us(bool maximum) const;
+    Sample      values_at(uint64_t time) const;
+    void        encode_calibration();
+    // adc values that the compensation turns into the physical values
+    int32_t     inverse_temperature(double temperature, int32_t &t_fine) const;
+    int32_t     inverse_pressure(double pressure, int32_t t_fine) const;
+    int32_t     inverse_humidity(double humidity, int32_t t_fine) const;
+};
@@ -0,0 +1,203 @@
+/*
+ Runs the BME280 class against the register-level model (bme280_model.hpp)
+ and reports the bus usage of its measurement paths: transactions,
+ bytes, status reads and bus time per measurement, the time a call
+ takes, and the deviation of the results from the model input.
+ A BME280Group of two models on one bus shows what the second sensor
+ sees of the first one's traffic, with and without the group driving
+ both chip select pins high before the first sensor is initialised.
+
+ Usage: bme280_sim_bench [--noise] [values.csv | --raw trace.csv]
+ Without a file the input is a synthetic day with 1 minute samples.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <functional>
+#include "bme280_model.hpp"
+#include "bme280_spi.hpp"
+#include "bme280_group.hpp"
+
+#define CS_PIN      PICO_DEFAULT_SPI_CSN_PIN
+#define CS_PIN_2    20
+#define SPI_FREQ    (500 * 1000)
+#define ROUNDS      200
+#define INTERVAL_MS 1000
+
+static bool  noise = false;
+static const char *csv_path = NULL;
+static bool  raw = false;
+
+static void setup_input(BME280Model &model) {
+    model.set_noise(noise);
+    if (csv_path) {
+        if (!(raw ? model.load_raw_trace(csv_path) : model.load_csv(csv_path)))
+            printf("cannot read %s\n", csv_path);
+        return;
+    }
+    // one day: temperature 7 ... 23 degrees, pressure +-8 hPa, humidity 30 ... 70 %RH
+    for (uint64_t s = 0; s <= 24 * 3600; s += 60) {
+        double day = 2 * M_PI * s / (24 * 3600.0);
+        model.add_sample(s * 1000000ull, 15.0 + 8.0 * sin(day), 101325.0 + 800.0 * sin(2 * day),
+                         50.0 + 20.0 * cos(day));
+    }
+}
+
+struct Errors {
+    double temperature, pressure, humidity;
+};
+
+static void account(const BME280Model &model, const BME280::Measurement_t &values, uint64_t time_us, Errors &e) {
+    double t, p, h;
+    model.input_at(time_us, t, p, h);
+    if (values.valid & BME280::VALID_TEMPERATURE)
+        e.temperature = fmax(e.temperature, fabs(values.temperature - t));
+    if (values.valid & BME280::VALID_PRESSURE)
+        e.pressure    = fmax(e.pressure, fabs(values.pressure * 100.0 - p));
+    if (values.valid & BME280::VALID_HUMIDITY)
+        e.humidity    = fmax(e.humidity, fabs(values.humidity - h));
+}
+
+// one measurement path: step() measures once and returns the values
+static void run(const char *name, BME280::MODE mode, BME280::TRANSPORT transport,
+                std::function<void(BME280 &)> prepare,
+                std::function<BME280::Measurement_t(BME280 &)> step) {
+    BME280Model model;
+    setup_input(model);
+    sim_attach_spi(spi0, CS_PIN, &model);
+    BME280 sensor(0, PICO_DEFAULT_SPI_RX_PIN, PICO_DEFAULT_SPI_TX_PIN, PICO_DEFAULT_SPI_SCK_PIN,
+                  CS_PIN, SPI_FREQ, mode, transport);
+    if (sensor.get_chipID() != BME280Model::CHIP_ID)
+        printf("%s: wrong chip id 0x%02x\n", name, sensor.get_chipID());
+    BME280Model::Stats init = model.get_stats();
+    if (prepare)
+        prepare(sensor);
+    sleep_ms(INTERVAL_MS);
+    model.clear_stats();
+
+    Errors errors = { 0, 0, 0 };
+    uint64_t call_us = 0;
+    uint32_t failures = 0;
+    for (int i = 0; i < ROUNDS; i++) {
+        uint64_t t0 = time_us_64();
+        BME280::Measurement_t values = step(sensor);
+        call_us += time_us_64() - t0;
+        if (sensor.get_last_error() != PICO_OK)
+            failures++;
+        else
+            account(model, values, sensor.get_sample_time_us(), errors);
+        sleep_ms(INTERVAL_MS);
+    }
+    const BME280Model::Stats &s = model.get_stats();
+    printf("%-32s %5.2f %6.1f %5.2f %7.1f %8.1f   %6.3f %5.1f %6.3f",
+           name, (double) s.transactions / ROUNDS, (double) s.bytes / ROUNDS,
+           (double) s.status_reads / ROUNDS, (double) s.bus_time_us / ROUNDS,
+           (double) call_us / ROUNDS, errors.temperature, errors.pressure, errors.humidity);
+    if (failures)        printf("  %u timeouts", failures);
+    if (s.ignored_writes) printf("  %u ignored writes", s.ignored_writes);
+    printf("   (init: %u transactions, %u bytes)\n", init.transactions, init.bytes);
+    sim_detach_spi(&model);
+}
+
+// two sensors on one bus; the second model has its own calibration,
+// so calibration bytes it answers along with the first sensor are
+// seen in the errors of the first
+static void run_group(const char *name, std::initializer_list<uint> cs_pins) {
+    BME280Calibration calib = BME280Model::default_calibration();
+    calib.dig_T1 += 0x0101;
+    calib.dig_P1 -= 0x0302;
+    BME280Model first, second(calib);
+    setup_input(first);
+    setup_input(second);
+    sim_attach_spi(spi0, CS_PIN, &first);
+    sim_attach_spi(spi0, CS_PIN_2, &second);
+    BME280Group group(cs_pins);
+    BME280 indoor(group.get_spi(), CS_PIN);
+    BME280Model::Stats crosstalk = second.get_stats();
+    BME280 outdoor(group.get_spi(), CS_PIN_2);
+    group.add(indoor);
+    group.add(outdoor);
+    sleep_ms(INTERVAL_MS);
+    first.clear_stats();
+    second.clear_stats();
+
+    Errors errors[2] = { { 0, 0, 0 }, { 0, 0, 0 } };
+    const BME280Model *models[2] = { &first, &second };
+    uint64_t call_us = 0;
+    uint32_t missing = 0;
+    for (int i = 0; i < ROUNDS; i++) {
+        uint64_t t0 = time_us_64();
+        missing += group.size() - group.measure();
+        call_us += time_us_64() - t0;
+        for (uint k = 0; k < group.size(); k++)
+            account(*models[k], group.get(k).measurement, group.get(k).get_sample_time_us(), errors[k]);
+        sleep_ms(INTERVAL_MS);
+    }
+    for (uint k = 0; k < group.size(); k++) {
+        const BME280Model::Stats &s = models[k]->get_stats();
+        char call[16] = "";
+        if (k == 0)
+            snprintf(call, sizeof(call), "%.1f", (double) call_us / ROUNDS);
+        printf("%-32s %5.2f %6.1f %5.2f %7.1f %8s   %6.3f %5.1f %6.3f\n",
+               k ? "" : name, (double) s.transactions / ROUNDS, (double) s.bytes / ROUNDS,
+               (double) s.status_reads / ROUNDS, (double) s.bus_time_us / ROUNDS, call,
+               errors[k].temperature, errors[k].pressure, errors[k].humidity);
+    }
+    printf("%-32s second sensor before its init: %u transactions, %u bytes",
+           "", crosstalk.transactions, crosstalk.bytes);
+    if (missing) printf(", %u measurements missing", missing);
+    printf("\n");
+    sim_detach_spi(&second);
+    sim_detach_spi(&first);
+}
+
+typedef BME280::Config<BME280::OVERSAMPLING_X1, BME280::OVERSAMPLING_X1, BME280::OVERSAMPLING_SKIPPED> NoHumidity;
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--noise")) noise = true;
+        else if (!strcmp(argv[i], "--raw") && i + 1 < argc) { raw = true; csv_path = argv[++i]; }
+        else csv_path = argv[i];
+    }
+    spi_init(spi0, SPI_FREQ);
+
+    printf("%d measurements, SPI at %d kHz, per measurement:\n", ROUNDS, SPI_FREQ / 1000);
+    printf("%-32s %5s %6s %5s %7s %8s   %6s %5s %6s\n", "", "trans", "bytes", "stat",
+           "bus us", "call us", "err C", "Pa", "%RH");
+    run("measure()", BME280::MODE_FORCED, BME280::TRANSPORT_BLOCKING, nullptr,
+        [](BME280 &s) { return s.measure(); });
+    run("measure(), DMA", BME280::MODE_FORCED, BME280::TRANSPORT_DMA, nullptr,
+        [](BME280 &s) { return s.measure(); });
+    run("measure() normal mode", BME280::MODE_NORMAL, BME280::TRANSPORT_BLOCKING, nullptr,
+        [](BME280 &s) { return s.measure(); });
+    run("measure<T x1, P x1, H skipped>()", BME280::MODE_FORCED, BME280::TRANSPORT_BLOCKING,
+        [](BME280 &s) { s.configure<NoHumidity>(); },
+        [](BME280 &s) { return s.measure<NoHumidity>(); });
+    run("measure_scheduled() 1/10/60 s", BME280::MODE_FORCED, BME280::TRANSPORT_BLOCKING,
+        [](BME280 &s) { s.set_schedule(0, 10000, 60000); },
+        [](BME280 &s) { return s.measure_scheduled(); });
+    run("start_measurement/try_collect", BME280::MODE_FORCED, BME280::TRANSPORT_BLOCKING, nullptr,
+        [](BME280 &s) {
+            BME280::Measurement_t values;
+            sleep_until(s.start_measurement());
+            s.try_collect(values);
+            return values;
+        });
+    run("prefetch/collect_prefetched", BME280::MODE_FORCED, BME280::TRANSPORT_BLOCKING,
+        [](BME280 &s) { s.prefetch(); },
+        [](BME280 &s) {
+            BME280::Measurement_t values;
+            if (!s.collect_prefetched(values))
+                values = s.measure();
+            s.prefetch(); // before the sleep, outside of the time of the call
+            return values;
+        });
+    // one line per sensor, the call time is that of the whole group
+    run_group("BME280Group, CS not driven", {});
+    run_group("BME280Group", { CS_PIN, CS_PIN_2 });
+    return 0;
+}
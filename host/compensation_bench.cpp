@@ -0,0 +1,127 @@
+/*
+ Host benchmark for the batch compensation: checks that every
+ instruction set yields the results of the scalar routines bit by bit,
+ then measures the throughput in samples/s per core.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include "bme280_batch.hpp"
+
+// calibration of a real sensor
+static const BME280Calibration sensor = {
+    27504, 26435, -1000,
+    36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+    75, 0, 30, 362, 339, 0
+};
+
+struct Batch {
+    std::vector<int32_t>  adc_T, adc_P, adc_H;
+    std::vector<int32_t>  temperature;
+    std::vector<uint32_t> pressure, humidity;
+
+    explicit Batch(size_t n) : adc_T(n), adc_P(n), adc_H(n), temperature(n), pressure(n), humidity(n) {}
+    size_t size() const { return adc_T.size(); }
+    void run(const BME280Calibration &calib, unsigned threads, BME280BatchISA isa) {
+        bme280_compensate_batch(calib, adc_T.data(), adc_P.data(), adc_H.data(),
+                                temperature.data(), pressure.data(), humidity.data(),
+                                size(), threads, isa);
+    }
+};
+
+static const struct { BME280BatchISA isa; const char *name; } isas[] = {
+    { BME280_BATCH_SCALAR, "scalar" },
+    { BME280_BATCH_SSE41,  "SSE4.1" },
+    { BME280_BATCH_AVX2,   "AVX2"   }
+};
+
+// all adc values and random calibrations, compared with the scalar routines
+static bool check(std::mt19937 &rng) {
+    const size_t n = 1 << 20;
+    Batch batch(n);
+    std::vector<int32_t>  temperature(n);
+    std::vector<uint32_t> pressure(n), humidity(n);
+
+    for (int round = 0; round < 16; round++) {
+        BME280Calibration calib = sensor;
+        if (round > 0) {
+            // keep dig_P1 and dig_T1 of the sensor, so that some pressures are valid
+            calib.dig_T2 = rng(); calib.dig_T3 = rng();
+            calib.dig_P2 = rng(); calib.dig_P3 = rng(); calib.dig_P4 = rng(); calib.dig_P5 = rng();
+            calib.dig_P6 = rng(); calib.dig_P7 = rng(); calib.dig_P8 = rng(); calib.dig_P9 = rng();
+            calib.dig_H1 = rng(); calib.dig_H2 = rng(); calib.dig_H3 = rng();
+            calib.dig_H4 = rng() & 0xfff; calib.dig_H5 = rng() & 0xfff; calib.dig_H6 = rng();
+            if (calib.dig_H4 & 0x800) calib.dig_H4 |= 0xf000;
+            if (calib.dig_H5 & 0x800) calib.dig_H5 |= 0xf000;
+        }
+        for (size_t i = 0; i < n; i++) {
+            batch.adc_T[i] = (round == 0) ? (int32_t) i : (int32_t) (rng() & 0xfffff);
+            batch.adc_P[i] = rng() & 0xfffff;
+            batch.adc_H[i] = rng() & 0xffff;
+            int32_t t_fine;
+            temperature[i] = bme280_compensate_temperature(calib, batch.adc_T[i], t_fine);
+            pressure[i]    = bme280_compensate_pressure(calib, batch.adc_P[i], t_fine);
+            humidity[i]    = bme280_compensate_humidity(calib, batch.adc_H[i], t_fine);
+        }
+        for (auto &entry : isas) {
+            if (!bme280_batch_supported(entry.isa)) continue;
+            // an odd count leaves a tail for the scalar code
+            memset(batch.pressure.data(), 0xff, n * sizeof(uint32_t));
+            bme280_compensate_batch(calib, batch.adc_T.data(), batch.adc_P.data(), batch.adc_H.data(),
+                                    batch.temperature.data(), batch.pressure.data(), batch.humidity.data(),
+                                    n - 3, 0, entry.isa);
+            for (size_t i = 0; i < n - 3; i++) {
+                if (batch.temperature[i] != temperature[i] || batch.pressure[i] != pressure[i] ||
+                    batch.humidity[i] != humidity[i]) {
+                    printf("%s differs from scalar: round %d, sample %zu\n", entry.name, round, i);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::mt19937 rng(280);
+    if (!check(rng))
+        return 1;
+    printf("all instruction sets are bit-exact with the scalar routines\n");
+
+    // a plausible record: 15 to 30 degrees, 950 to 1050 hPa, 20 to 80 %RH
+    const size_t n = 1 << 24;
+    Batch batch(n);
+    for (size_t i = 0; i < n; i++) {
+        batch.adc_T[i] = 500000 + rng() % 60000;
+        batch.adc_P[i] = 300000 + rng() % 60000;
+        batch.adc_H[i] = 20000 + rng() % 30000;
+    }
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    printf("%zu samples, %u core%s:\n", n, cores, cores == 1 ? "" : "s");
+    for (auto &entry : isas) {
+        if (!bme280_batch_supported(entry.isa)) {
+            printf("  %-8s not supported\n", entry.name);
+            continue;
+        }
+        for (unsigned threads = 1; threads <= cores; threads = (threads < cores) ? cores : cores + 1) {
+            batch.run(sensor, threads, entry.isa); // warm-up
+            auto t0 = std::chrono::steady_clock::now();
+            const int rounds = 4;
+            for (int r = 0; r < rounds; r++)
+                batch.run(sensor, threads, entry.isa);
+            double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            double rate = n * rounds / s;
+            printf("  %-8s %2u thread%s %8.1f Msamples/s, %7.1f Msamples/s per core\n",
+                   entry.name, threads, threads == 1 ? " " : "s", rate / 1e6, rate / threads / 1e6);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ Host benchmark for BME280Derived: compares the fixed-point
+ metrics with float reference implementations using libm,
+ both in accuracy and in time per call.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include "bme280_derived.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t cycles() { return __rdtsc(); }
+#else
+static uint64_t cycles() { return 0; }
+#endif
+
+// references with libm: temperature in degrees celsius, humidity in %RH;
+// the double instances measure the accuracy, the float ones the time
+
+template <typename F>
+static F dew_point_ref(F t, F rh) {
+    F g = std::log(rh / 100) + F(17.62) * t / (F(243.12) + t);
+    return F(243.12) * g / (F(17.62) - g);
+}
+
+template <typename F>
+static F absolute_humidity_ref(F t, F rh) {
+    F e = rh / 100 * F(611.2) * std::exp(F(17.62) * t / (F(243.12) + t));
+    return 2167 * e / (t + F(273.15)); // mg/m^3
+}
+
+template <typename F>
+static F heat_index_ref(F t, F rh) {
+    F f = t * 9 / 5 + 32;
+    F hi = F(0.5) * (f + 61 + (f - 68) * F(1.2) + rh * F(0.094));
+    if ((hi + f) / 2 >= 80) {
+        hi = F(-42.379) + F(2.04901523) * f + F(10.14333127) * rh - F(0.22475541) * f * rh
+           - F(0.00683783) * f * f - F(0.05481717) * rh * rh + F(0.00122874) * f * f * rh
+           + F(0.00085282) * f * rh * rh - F(0.00000199) * f * f * rh * rh;
+        if (rh < 13 && f >= 80 && f <= 112)
+            hi -= (13 - rh) / 4 * std::sqrt((17 - std::fabs(f - 95)) / 17);
+        else if (rh > 85 && f >= 80 && f <= 87)
+            hi += (rh - 85) / 10 * (87 - f) / 5;
+    }
+    return (hi - 32) * 5 / 9;
+}
+
+template <typename F>
+static F sea_level_pressure_ref(F t, F p, F h) {
+    return p * std::pow(1 - F(0.0065) * h / (t + F(0.0065) * h + F(273.15)), F(-5.257));
+}
+
+struct Sample {
+    int32_t  temperature;   // 0.01 degrees celsius
+    uint32_t humidity;      // 1/1024 %RH
+    uint32_t pressure;      // Pa
+    int32_t  elevation;     // cm
+};
+
+int main() {
+    // grid over the sensor range
+    std::vector<Sample> samples;
+    for (int32_t t = -4000; t <= 8500; t += 37)
+        for (uint32_t h = 1024; h <= 102400; h += 997)
+            samples.push_back({t, h, 30000 + (uint32_t) samples.size() * 7 % 80000,
+                               (int32_t) (samples.size() * 13 % 300000)});
+
+    double err_dp = 0, err_ah = 0, err_ah_rel = 0, err_hi = 0, err_slp = 0;
+    for (const Sample &s : samples) {
+        double t = s.temperature / 100.0, rh = s.humidity / 1024.0;
+        err_dp = fmax(err_dp, fabs(BME280Derived::compute_dew_point(s.temperature, s.humidity) / 100.0
+                                   - dew_point_ref(t, rh)));
+        double ah = absolute_humidity_ref(t, rh);
+        double ah_fixed = BME280Derived::compute_absolute_humidity(s.temperature, s.humidity);
+        err_ah = fmax(err_ah, fabs(ah_fixed - ah));
+        if (ah >= 1000.0)
+            err_ah_rel = fmax(err_ah_rel, fabs(ah_fixed - ah) / ah);
+        double hi = heat_index_ref(t, rh);
+        if (hi <= 70.0) // the regression is meaningless beyond
+            err_hi = fmax(err_hi, fabs(BME280Derived::compute_heat_index(s.temperature, s.humidity) / 100.0 - hi));
+        err_slp = fmax(err_slp, fabs((double) BME280Derived::compute_sea_level_pressure(s.temperature, s.pressure, s.elevation)
+                                     - sea_level_pressure_ref(t, (double) s.pressure, s.elevation / 100.0)));
+    }
+    printf("%zu samples, maximum deviation from the double reference:\n", samples.size());
+    printf("  dew point          %.4f degrees\n", err_dp);
+    printf("  absolute humidity  %.2f mg/m^3, %.4f %% above 1 g/m^3\n", err_ah, err_ah_rel * 100.0);
+    printf("  heat index         %.4f degrees up to 70 degrees\n", err_hi);
+    printf("  sea-level pressure %.2f Pa\n", err_slp);
+
+    // time per call, the sums keep the compiler from dropping the work
+    const int rounds = 20;
+    volatile int64_t fixed_sum = 0;
+    volatile float   float_sum = 0;
+    auto bench = [&](const char *name, auto fixed, auto reference) {
+        uint64_t c0 = cycles();
+        auto t0 = std::chrono::steady_clock::now();
+        int64_t fs = 0;
+        for (int r = 0; r < rounds; r++)
+            for (const Sample &s : samples)
+                fs += fixed(s);
+        auto t1 = std::chrono::steady_clock::now();
+        uint64_t c1 = cycles();
+        float rs = 0;
+        for (int r = 0; r < rounds; r++)
+            for (const Sample &s : samples)
+                rs += reference(s);
+        auto t2 = std::chrono::steady_clock::now();
+        uint64_t c2 = cycles();
+        fixed_sum = fixed_sum + fs;
+        float_sum = float_sum + rs;
+        double n = (double) rounds * samples.size();
+        printf("  %-18s fixed %6.1f ns %6.1f cycles   float %6.1f ns %6.1f cycles\n", name,
+               std::chrono::duration<double, std::nano>(t1 - t0).count() / n, (c1 - c0) / n,
+               std::chrono::duration<double, std::nano>(t2 - t1).count() / n, (c2 - c1) / n);
+    };
+    printf("time per call:\n");
+    bench("dew point",
+          [](const Sample &s) { return (int64_t) BME280Derived::compute_dew_point(s.temperature, s.humidity); },
+          [](const Sample &s) { return dew_point_ref(s.temperature / 100.0f, s.humidity / 1024.0f); });
+    bench("absolute humidity",
+          [](const Sample &s) { return (int64_t) BME280Derived::compute_absolute_humidity(s.temperature, s.humidity); },
+          [](const Sample &s) { return absolute_humidity_ref(s.temperature / 100.0f, s.humidity / 1024.0f); });
+    bench("heat index",
+          [](const Sample &s) { return (int64_t) BME280Derived::compute_heat_index(s.temperature, s.humidity); },
+          [](const Sample &s) { return heat_index_ref(s.temperature / 100.0f, s.humidity / 1024.0f); });
+    bench("sea-level pressure",
+          [](const Sample &s) { return (int64_t) BME280Derived::compute_sea_level_pressure(s.temperature, s.pressure, s.elevation); },
+          [](const Sample &s) { return sea_level_pressure_ref(s.temperature / 100.0f, (float) s.pressure, s.elevation / 100.0f); });
+    printf("On the host both variants use hardware arithmetic. The Cortex-M0+ has no\n"
+           "FPU, there the float variants run in software and the gap is much larger.\n");
+    return 0;
+}
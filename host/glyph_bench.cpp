@@ -0,0 +1,150 @@
+/*
+ Measures how many glyphs per second ss_oled draws with write_string()
+ into the back buffer (bRender=0, so no bus time), for each font size,
+ normal and inverted, with the glyphs prepared for each character and
+ copied from a glyph cache. Without a back buffer the numbers show the
+ cost of preparing the glyphs alone. A second table compares the
+ proportional fonts of src/ (host/fonts, converted with bdf2font),
+ drawn with draw_string() at a text row and between two, with the
+ fixed fonts they were made from.
+
+ Usage: glyph_bench [milliseconds per case]
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "ssd1306_model.hpp"
+#include "ss_oled.hpp"
+#include "font_small_prop.h"
+#include "font_large_prop.h"
+
+#define OLED_ADDR   0x3c
+#define I2C_SPEED   (100 * 1000)
+#define MS_PER_CASE 300
+
+static uint8_t ucBuffer[1024];
+static OLEDGLYPHS cache;
+static uint8_t ucGlyphs[OLED_GLYPH_CHARS * OLED_GLYPH_BYTES(FONT_16x32)];
+
+struct Font {
+    const char *name;
+    int         size;
+};
+
+static const Font fonts[] = {
+    { "6x8",   FONT_6x8 },
+    { "8x8",   FONT_8x8 },
+    { "12x16", FONT_12x16 },
+    { "16x16", FONT_16x16 },
+    { "16x32", FONT_16x32 },
+};
+
+// two texts of 8 characters, alternating like changing measurements
+static char *texts[2] = { (char *) "21.3 hPa", (char *) "19.8 %RH" };
+
+// glyphs per second
+static double run(picoSSOLED &oled, int size, bool invert, int ms) {
+    using clock = std::chrono::steady_clock;
+    uint64_t glyphs = 0;
+    auto start = clock::now();
+    auto end = start + std::chrono::milliseconds(ms);
+    while (clock::now() < end) {
+        for (int i = 0; i < 256; i++)
+            oled.write_string(0, 0, 0, texts[i & 1], size, invert, 0);
+        glyphs += 256 * 8;
+    }
+    return glyphs / std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// glyphs per second of a proportional font at row y
+static double run_prop(picoSSOLED &oled, const uint8_t *font, int y, int ms) {
+    using clock = std::chrono::steady_clock;
+    uint64_t glyphs = 0;
+    auto start = clock::now();
+    auto end = start + std::chrono::milliseconds(ms);
+    while (clock::now() < end) {
+        for (int i = 0; i < 256; i++)
+            oled.draw_string(0, y, texts[i & 1], font, false);
+        glyphs += 256 * 8;
+    }
+    return glyphs / std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// characters of a sample text that fit on a line of 128 pixels
+static int per_line(const uint8_t *font) {
+    static const char *sample = "Temperature 21.3 C, humidity 48.2 %RH, pressure 1013.2 hPa";
+    char line[64];
+    int n = 0;
+    while (sample[n]) {
+        memcpy(line, sample, n + 1);
+        line[n + 1] = 0;
+        if (picoSSOLED::string_width(line, font) > 128)
+            break;
+        n++;
+    }
+    return n;
+}
+
+int main(int argc, char **argv) {
+    int ms = argc > 1 ? atoi(argv[1]) : MS_PER_CASE;
+
+    SSD1306Model panel(128, 64);
+    sim_attach_i2c(i2c0, OLED_ADDR, &panel);
+    picoSSOLED oled(OLED_128x64, OLED_ADDR, 0, 0, i2c0, 4, 5, I2C_SPEED);
+    if (oled.init() == OLED_NOT_FOUND)
+        printf("display not found\n");
+
+    printf("Mglyphs/s, write_string() with bRender=0\n");
+    printf("%-14s %22s %22s\n", "", "no buffer", "back buffer");
+    printf("%-14s %11s %10s %11s %10s\n", "font", "prepared", "cached", "prepared", "cached");
+    for (const Font &f : fonts) {
+        for (int invert = 0; invert < 2; invert++) {
+            double rate[2][2]; // [back buffer][cached]
+            for (int buffer = 0; buffer < 2; buffer++) {
+                oled.set_back_buffer(buffer ? ucBuffer : NULL);
+                rate[buffer][0] = run(oled, f.size, invert, ms);
+                oled.add_glyph_cache(&cache, f.size, invert, ucGlyphs, sizeof(ucGlyphs));
+                rate[buffer][1] = run(oled, f.size, invert, ms);
+                oled.remove_glyph_cache(&cache);
+            }
+            char name[20];
+            snprintf(name, sizeof(name), "%s%s", f.name, invert ? " inverted" : "");
+            printf("%-14s %11.2f %10.2f %11.2f %10.2f\n", name, rate[0][0] / 1e6, rate[0][1] / 1e6,
+                   rate[1][0] / 1e6, rate[1][1] / 1e6);
+        }
+    }
+
+    struct Prop {
+        const char    *name;
+        const uint8_t *font;
+        size_t         bytes;
+        const char    *fixed;
+        int            fixed_bytes, fixed_width;
+    };
+    static const Prop props[] = {
+        { "small (8)",  ucSmallPropFont, sizeof(ucSmallPropFont), "6x8",   96 * 5,  6 },
+        { "large (32)", ucLargePropFont, sizeof(ucLargePropFont), "16x32", 96 * 64, 16 },
+    };
+    printf("\nproportional fonts, draw_string() into the back buffer: Mglyphs/s at y=0 and y=3,\n"
+           "characters of a sample text per line against the fixed font\n");
+    printf("%-12s %6s %8s %6s %8s %7s %7s\n", "font", "bytes", "fixed", "bytes", "chars", "y=0", "y=3");
+    oled.set_back_buffer(ucBuffer);
+    bool matches = true;
+    for (const Prop &p : props) {
+        double aligned = run_prop(oled, p.font, 0, ms);
+        double shifted = run_prop(oled, p.font, 3, ms);
+        oled.flush();
+        matches = matches && panel.matches(ucBuffer);
+        printf("%-12s %6zu %8s %6d %4d/%-3d %7.2f %7.2f\n", p.name, p.bytes, p.fixed, p.fixed_bytes,
+               per_line(p.font), 128 / p.fixed_width, aligned / 1e6, shifted / 1e6);
+    }
+    if (!matches)
+        printf("display RAM differs from the back buffer\n");
+    sim_detach_i2c(&panel);
+    return 0;
+}
@@ -0,0 +1,333 @@
+/*
+ Runs the ss_oled library against the SSD1306 model (ssd1306_model.hpp)
+ and reports the I2C bytes per frame of the SleepyPico weather screen:
+ redrawn completely with rendered strings, as SleepyPico did before
+ dirty tiles, and drawn into the back buffer with flush(), blocking
+ or as a DMA stream, or with the old drawing code inside
+ begin_frame()/end_frame() (with and without a frame copy that
+ lets end_frame() skip tiles redrawn unchanged), or as an OLEDLayout
+ whose value widgets rewrite the changed characters only, on an
+ SSD1306 (page runs or a window in horizontal addressing mode) and
+ an SH1106 (page runs only). A second table gives
+ the bytes of full frames, a third both on 4-wire SPI. The last one
+ compares a text ticker moved in the back buffer (scroll_buffer()) with
+ one moved by the display start line of the controller, and checks
+ that flushes during a hardware scroll leave the display RAM alone.
+ Each frame checks that the display RAM equals the back buffer.
+
+ Usage: oled_bench [frames]
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <functional>
+#include <vector>
+#include "ssd1306_model.hpp"
+#include "ss_oled.hpp"
+#include "oled_layout.hpp"
+
+#define OLED_ADDR   0x3c
+#define I2C_SPEED   (100 * 1000)
+#define SPI_SPEED   (10 * 1000 * 1000)
+#define SPI_SCK     18
+#define SPI_MOSI    19
+#define SPI_CS      17
+#define SPI_DC      20
+#define SPI_RESET   21
+#define FRAMES      100
+
+static uint8_t ucBuffer[1024];
+static uint8_t ucFrameCopy[1024]; // for FRAME_COPY
+static uint16_t u16Stream[OLED_STREAM_LEN(64)];
+
+enum PATH { RENDER, FLUSH, FLUSH_DMA, DUMP, FRAME, FRAME_COPY };
+
+// the values of frame i: a slow day cycle, like measurements every 20 s
+static void weather_values(int i, double v[4]) {
+    double day = 2 * M_PI * i / (24 * 180.0);
+    v[0] = 15.0 + 8.0 * sin(day);
+    v[1] = 50.0 + 20.0 * cos(day);
+    v[2] = 1013.25 + 8.0 * sin(2 * day);
+    v[3] = 44330.0 * (1.0 - pow(v[2] / 1013.25, 0.1903));
+}
+
+static void weather_strings(int i, char tem[30], char hum[30], char prs[30], char alt[30]) {
+    double v[4];
+    weather_values(i, v);
+    sprintf(tem, "tem: %6.1f C",   v[0]);
+    sprintf(hum, "hum: %6.1f %c",  v[1], '%');
+    sprintf(prs, "prs: %6.1f hPa", v[2]);
+    sprintf(alt, "alt: %6.1f m",   v[3]);
+}
+
+static void weather(picoSSOLED &oled, int i, bool render) {
+    char tem[30], hum[30], prs[30], alt[30];
+    weather_strings(i, tem, hum, prs, alt);
+    if (render)
+        oled.fill(0,1);
+    oled.write_string(0,0,1,(char *)" Weather Today ", FONT_8x8, 0, render);
+    oled.write_string(0,0,3,tem, FONT_8x8, 0, render);
+    oled.write_string(0,0,4,hum, FONT_8x8, 0, render);
+    oled.write_string(0,0,5,prs, FONT_8x8, 0, render);
+    oled.write_string(0,0,6,alt, FONT_8x8, 0, render);
+}
+
+// the SleepyPico screen as an OLEDLayout: static labels, value widgets;
+// built (and drawn into the back buffer) with the first frame of a run
+static void weather_layout(picoSSOLED &oled, int i, bool) {
+    static OLEDLayout *layout = NULL;
+    static int ids[4];
+    if (i == 0) {
+        delete layout;
+        layout = new OLEDLayout(oled);
+        static const char *labels[4] = { "tem:", "hum:", "prs:", "alt:" };
+        static const char *units[4]  = { " C", " %", " hPa", " m" };
+        layout->add_text(0, 1, " Weather Today ", FONT_8x8);
+        for (int v = 0; v < 4; v++) {
+            layout->add_text(0,  3 + v, labels[v], FONT_8x8);
+            layout->add_text(88, 3 + v, units[v],  FONT_8x8);
+            ids[v] = layout->add_value(40, 3 + v, "%6.1f", 6, FONT_8x8);
+        }
+        layout->draw();
+    }
+    double v[4];
+    weather_values(i, v);
+    for (int k = 0; k < 4; k++)
+        layout->set_value(ids[k], v[k]);
+}
+
+// a full frame of changing content
+static void full_frame(picoSSOLED &oled, int i) {
+    for (int b = 0; b < 1024; b++)
+        ucBuffer[b] = (uint8_t) (b * 7 + i * 13);
+    oled.set_dirty(0, 0, 127, 63);
+}
+
+struct Result {
+    uint32_t first, min, max, total, transactions;
+    uint64_t bus_us;
+    int      mismatches;
+};
+
+// draw(oled, i, render) draws frame i; RENDER sends it while drawing
+static Result run(PATH path, bool sh1106, bool spi, int frames,
+                  std::function<void(picoSSOLED &, int, bool)> draw) {
+    SSD1306Model panel(128, 64, sh1106);
+    sim_attach_i2c(i2c0, OLED_ADDR, &panel);
+    sim_attach_spi(spi0, SPI_CS, &panel);
+    panel.set_dc_pin(SPI_DC);
+    int type = sh1106 ? OLED_132x64 : OLED_128x64;
+    picoSSOLED oled = spi ? picoSSOLED(type, 0, 0, spi0, SPI_SCK, SPI_MOSI, SPI_CS, SPI_DC, SPI_RESET, SPI_SPEED)
+                          : picoSSOLED(type, OLED_ADDR, 0, 0, i2c0, 4, 5, I2C_SPEED);
+    if (oled.init() == OLED_NOT_FOUND)
+        printf("display not found\n");
+    oled.set_back_buffer(ucBuffer);
+    oled.set_frame_copy(path == FRAME_COPY ? ucFrameCopy : NULL);
+    if (path == FLUSH_DMA && !oled.set_dma_stream(u16Stream, OLED_STREAM_LEN(64)))
+        printf("no DMA stream\n");
+    // welcome screen
+    oled.fill(0,1);
+    oled.write_string(0,0,1,(char *)" Weather Today ", FONT_8x8, 0, 1);
+    oled.write_string(0,0,3,(char *)" SLEEP mode", FONT_8x8, 0, 1);
+    if (path != RENDER)
+        oled.fill(0,0);
+
+    Result r = { 0, UINT32_MAX, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < frames; i++) {
+        panel.clear_stats();
+        uint64_t t0 = time_us_64();
+        bool frame = (path == FRAME || path == FRAME_COPY);
+        if (frame)
+            oled.begin_frame();
+        draw(oled, i, path == RENDER || frame);
+        if (frame)
+            oled.end_frame();
+        if (path == FLUSH)
+            oled.flush();
+        if (path == FLUSH_DMA) {
+            oled.flush_start();
+            oled.flush_wait();
+        }
+        if (path == DUMP)
+            oled.dump_buffer(NULL);
+        r.bus_us += time_us_64() - t0;
+        uint32_t bytes = panel.get_stats().bytes;
+        if (i == 0) r.first = bytes;
+        else {
+            if (bytes < r.min) r.min = bytes;
+            if (bytes > r.max) r.max = bytes;
+            r.total += bytes;
+            r.transactions += panel.get_stats().transactions;
+        }
+        if (!panel.matches(ucBuffer, sh1106 ? 2 : 0))
+            r.mismatches++;
+    }
+    oled.set_dma_stream(NULL, 0);
+    sim_detach_i2c(&panel);
+    sim_detach_spi(&panel);
+    return r;
+}
+
+// a ticker: with each step a new line of text enters at the bottom and
+// the others move up by a line. In software the back buffer moves with
+// scroll_buffer() and all of it is sent again, in hardware the start line
+// moves by 8 rows and only the new line is sent, into the page that
+// wrapped around to the bottom. screens holds what the panel shows after
+// each step: filled by the software run, compared by the hardware run
+static Result ticker(bool hardware, int frames, std::vector<std::vector<uint8_t>> &screens) {
+    SSD1306Model panel(128, 64);
+    sim_attach_i2c(i2c0, OLED_ADDR, &panel);
+    picoSSOLED oled(OLED_128x64, OLED_ADDR, 0, 0, i2c0, 4, 5, I2C_SPEED);
+    if (oled.init() == OLED_NOT_FOUND)
+        printf("display not found\n");
+    oled.set_back_buffer(ucBuffer);
+    oled.fill(0,1);
+
+    Result r = { 0, UINT32_MAX, 0, 0, 0, 0, 0 };
+    for (int i = 0; i < frames; i++) {
+        char line[20]; // 16 characters fit the width, room for any int
+        snprintf(line, sizeof(line), "ticker %-9d", i);
+        panel.clear_stats();
+        uint64_t t0 = time_us_64();
+        int page = 7;
+        if (hardware) {
+            page = oled.get_start_line() / 8; // the top page wraps around to the bottom
+            oled.set_start_line((page + 1) % 8 * 8);
+        }
+        else {
+            for (int k = 0; k < 8; k++)
+                oled.scroll_buffer(0, 127, 0, 7, true);
+        }
+        oled.write_string(0, 0, page, line, FONT_8x8, 0, 0);
+        oled.flush();
+        r.bus_us += time_us_64() - t0;
+        uint32_t bytes = panel.get_stats().bytes;
+        if (i == 0) r.first = bytes;
+        else {
+            if (bytes < r.min) r.min = bytes;
+            if (bytes > r.max) r.max = bytes;
+            r.total += bytes;
+            r.transactions += panel.get_stats().transactions;
+        }
+        if (!panel.matches(ucBuffer))
+            r.mismatches++;
+        // the panel shows the RAM from the start line on
+        std::vector<uint8_t> screen(1024);
+        int top = panel.get_start_line() / 8;
+        for (int p = 0; p < 8; p++)
+            memcpy(&screen[p * 128], &panel.get_ram()[((top + p) % 8) * 128], 128);
+        if (!hardware)
+            screens.push_back(screen);
+        else if (i >= (int) screens.size() || screens[i] != screen)
+            r.mismatches++;
+    }
+    sim_detach_i2c(&panel);
+    return r;
+}
+
+// the bytes that start a hardware scroll; it runs without bus traffic
+static uint32_t scroll_start_bytes() {
+    SSD1306Model panel(128, 64);
+    sim_attach_i2c(i2c0, OLED_ADDR, &panel);
+    picoSSOLED oled(OLED_128x64, OLED_ADDR, 0, 0, i2c0, 4, 5, I2C_SPEED);
+    oled.init();
+    panel.clear_stats();
+    if (!oled.scroll_start(OLED_SCROLL_LEFT, 0, 7, 2) || !panel.is_scrolling())
+        printf("no hardware scroll\n");
+    uint32_t bytes = panel.get_stats().bytes;
+    sim_detach_i2c(&panel);
+    return bytes;
+}
+
+// a status line redrawn and flushed while the pages above it scroll:
+// the flushes must not write the display RAM, the first one after
+// scroll_stop() sends what changed
+static void scroll_flush(int frames) {
+    SSD1306Model panel(128, 64);
+    sim_attach_i2c(i2c0, OLED_ADDR, &panel);
+    picoSSOLED oled(OLED_128x64, OLED_ADDR, 0, 0, i2c0, 4, 5, I2C_SPEED);
+    oled.init();
+    oled.set_back_buffer(ucBuffer);
+    oled.fill(0,1);
+    oled.write_string(0,0,1,(char *)" Weather Today ", FONT_8x8, 0, 1);
+    oled.scroll_start(OLED_SCROLL_LEFT, 0, 3, 2);
+    panel.clear_stats();
+    uint32_t sent = 0;
+    for (int i = 0; i < frames; i++) {
+        char line[20]; // 16 characters fit the width, room for any int
+        snprintf(line, sizeof(line), "status %-9d", i);
+        oled.write_string(0,0,7,line, FONT_8x8, 0, 1);
+        sent += oled.flush();
+    }
+    uint32_t scroll_bytes = panel.get_stats().scroll_data_bytes;
+    panel.clear_stats();
+    oled.scroll_stop();
+    int stop_bytes = oled.flush();
+    printf("flush() while scrolling: %u bytes in %d flushes, %u to the display RAM;\n"
+           "scroll_stop() + flush(): %d bytes, display %s the back buffer\n",
+           sent, frames, scroll_bytes, stop_bytes,
+           panel.matches(ucBuffer, 0) ? "matches" : "differs from");
+    sim_detach_i2c(&panel);
+}
+
+static void report(const char *name, const Result &r, int frames) {
+    printf("%-36s %6u %6u %6u %8.1f %6.1f %8.2f", name, r.first, r.min, r.max,
+           (double) r.total / (frames - 1), (double) r.transactions / (frames - 1),
+           (double) r.bus_us / frames / 1000.0);
+    if (r.mismatches)
+        printf("  %d frames differ from the back buffer", r.mismatches);
+    printf("\n");
+}
+
+static void header(const char *title) {
+    printf("\n%-36s %6s %6s %6s %8s %6s %8s\n", title, "first", "min", "max", "mean", "trans", "ms");
+}
+
+int main(int argc, char **argv) {
+    int frames = argc > 1 ? atoi(argv[1]) : FRAMES;
+    if (frames < 2) frames = 2;
+
+    printf("128x64, I2C at %d kHz, %d frames; bytes per frame after the address byte\n"
+           "and transactions (one address byte each) per frame after the first\n", I2C_SPEED / 1000, frames);
+    header("SleepyPico weather screen");
+    report("fill(0,1) + rendered strings", run(RENDER, false, false, frames, weather), frames);
+    report("flush(), SH1106", run(FLUSH, true, false, frames, weather), frames);
+    report("flush(), SSD1306", run(FLUSH, false, false, frames, weather), frames);
+    report("flush_start(), SSD1306, DMA", run(FLUSH_DMA, false, false, frames, weather), frames);
+    report("fill(0,1) + rendered strings, frame", run(FRAME, false, false, frames, weather), frames);
+    report("the same with a frame copy", run(FRAME_COPY, false, false, frames, weather), frames);
+    report("OLEDLayout value widgets, frame", run(FRAME, false, false, frames, weather_layout), frames);
+
+    header("full frames");
+    auto full = [](picoSSOLED &oled, int i, bool) { full_frame(oled, i); };
+    report("dump_buffer()", run(DUMP, false, false, frames, full), frames);
+    report("flush(), SH1106", run(FLUSH, true, false, frames, full), frames);
+    report("flush(), SSD1306", run(FLUSH, false, false, frames, full), frames);
+    report("flush_start(), SSD1306, DMA", run(FLUSH_DMA, false, false, frames, full), frames);
+
+    printf("\nthe same on 4-wire SPI at %d MHz: bytes per frame, no control bytes,\n"
+           "and transactions (chip select low) per frame after the first\n", SPI_SPEED / 1000000);
+    header("SleepyPico weather screen, SPI");
+    report("flush(), SH1106", run(FLUSH, true, true, frames, weather), frames);
+    report("flush(), SSD1306", run(FLUSH, false, true, frames, weather), frames);
+    report("flush_start(), SSD1306, DMA", run(FLUSH_DMA, false, true, frames, weather), frames);
+    report("OLEDLayout value widgets, frame", run(FRAME, false, true, frames, weather_layout), frames);
+    header("full frames, SPI");
+    report("dump_buffer()", run(DUMP, false, true, frames, full), frames);
+    report("flush(), SH1106", run(FLUSH, true, true, frames, full), frames);
+    report("flush(), SSD1306", run(FLUSH, false, true, frames, full), frames);
+    report("flush_start(), SSD1306, DMA", run(FLUSH_DMA, false, true, frames, full), frames);
+
+    std::vector<std::vector<uint8_t>> screens;
+    header("ticker, a line per step, I2C");
+    report("scroll_buffer() + flush()", ticker(false, frames, screens), frames);
+    report("set_start_line() + flush()", ticker(true, frames, screens), frames);
+    printf("scroll_start(): %u bytes, then the controller scrolls on its own\n", scroll_start_bytes());
+    scroll_flush(frames);
+    return 0;
+}
@@ -0,0 +1,36 @@
+/*
+ Host stand-in for hardware/gpio.h. Output levels are kept so that
+ simulated devices see their chip select (see pico_sim.hpp).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum gpio_function {
+    GPIO_FUNC_XIP = 0, GPIO_FUNC_SPI = 1, GPIO_FUNC_UART = 2, GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5, GPIO_FUNC_PIO0 = 6, GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8, GPIO_FUNC_USB = 9, GPIO_FUNC_NULL = 0x1f,
+};
+
+#define GPIO_OUT 1
+#define GPIO_IN  0
+
+void gpio_init(uint gpio);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+static inline void gpio_pull_up(uint gpio) { (void) gpio; }
+static inline void gpio_pull_down(uint gpio) { (void) gpio; }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,36 @@
+/*
+ Host stand-in for hardware/i2c.h. Transactions go to the simulated
+ device at the address (see pico_sim.hpp); each byte, the address
+ byte included, advances the simulated time by 9 clock periods.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct i2c_inst {
+    uint index;
+    uint baudrate;
+} i2c_inst_t;
+
+extern i2c_inst_t sim_i2c_units[2];
+#define i2c0 (&sim_i2c_units[0])
+#define i2c1 (&sim_i2c_units[1])
+
+static inline uint i2c_hw_index(i2c_inst_t *i2c) { return i2c->index; }
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+// PICO_ERROR_GENERIC if no device acknowledges the address
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
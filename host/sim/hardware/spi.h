@@ -0,0 +1,38 @@
+/*
+ Host stand-in for hardware/spi.h. The bytes go to the simulated
+ devices whose chip select is low (see pico_sim.hpp); each byte
+ advances the simulated time by 8 clock periods.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct spi_inst {
+    uint index;
+    uint baudrate;
+} spi_inst_t;
+
+extern spi_inst_t sim_spi_units[2];
+#define spi0 (&sim_spi_units[0])
+#define spi1 (&sim_spi_units[1])
+
+static inline uint spi_get_index(const spi_inst_t *spi) { return spi->index; }
+uint spi_init(spi_inst_t *spi, uint baudrate);
+void spi_deinit(spi_inst_t *spi);
+uint spi_set_baudrate(spi_inst_t *spi, uint baudrate);
+uint spi_get_baudrate(const spi_inst_t *spi);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len);
+int spi_write_read_blocking(spi_inst_t *spi, const uint8_t *src, uint8_t *dst, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
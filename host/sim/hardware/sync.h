@@ -0,0 +1,14 @@
+/*
+ Host stand-in for hardware/sync.h: the simulated transfers complete
+ before they return, so nothing waits for an event.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
@@ -0,0 +1,29 @@
+/*
+ Host stand-in for the Pico SDK: basic types and error codes.
+ Only what the SDK-dependent SleepyPico sources use on a host,
+ see pico_sim.hpp.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+enum pico_error_codes {
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+    PICO_ERROR_NO_DATA = -3,
+};
+
+#define PICO_DEFAULT_SPI_SCK_PIN    18
+#define PICO_DEFAULT_SPI_TX_PIN     19
+#define PICO_DEFAULT_SPI_RX_PIN     16
+#define PICO_DEFAULT_SPI_CSN_PIN    17
@@ -0,0 +1,11 @@
+/*
+ Host stand-in for pico/binary_info.h: there is no binary to annotate.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#define bi_decl(_decl)
+#define bi_decl_if_func_used(_decl)
@@ -0,0 +1,21 @@
+/*
+ Host stand-in for pico/mutex.h: the simulation has one core,
+ the mutex only counts its owner's nesting.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+typedef struct {
+    bool    initialized;
+    uint8_t enter_count;
+} recursive_mutex_t;
+
+static inline void recursive_mutex_init(recursive_mutex_t *mtx) { mtx->initialized = true; mtx->enter_count = 0; }
+static inline bool recursive_mutex_is_initialized(recursive_mutex_t *mtx) { return mtx->initialized; }
+static inline void recursive_mutex_enter_blocking(recursive_mutex_t *mtx) { mtx->enter_count++; }
+static inline void recursive_mutex_exit(recursive_mutex_t *mtx) { mtx->enter_count--; }
@@ -0,0 +1,13 @@
+/*
+ Host stand-in for pico/stdlib.h, see pico_sim.hpp.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <stdio.h>
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
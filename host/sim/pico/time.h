@@ -0,0 +1,45 @@
+/*
+ Host stand-in for pico/time.h. Time is simulated: it only advances
+ by sleeping and by bus transfers (see pico_sim.hpp), so runs are
+ reproducible and do not take real time.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t absolute_time_t;
+typedef int32_t  alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+uint64_t time_us_64(void);
+static inline absolute_time_t get_absolute_time(void) { return time_us_64(); }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) { return t + us; }
+static inline absolute_time_t make_timeout_time_us(uint64_t us) { return time_us_64() + us; }
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) { return time_us_64() + ms * 1000ull; }
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t) (to - from); }
+static inline bool time_reached(absolute_time_t t) { return time_us_64() >= t; }
+
+void sleep_until(absolute_time_t target);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+// alarms fire while the simulated time passes them
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past);
+static inline alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    return add_alarm_at(time_us_64() + us, callback, user_data, fire_if_past);
+}
+bool cancel_alarm(alarm_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
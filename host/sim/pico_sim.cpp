@@ -0,0 +1,337 @@
+/*
+ Simulated Pico for host builds, see pico_sim.hpp.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <vector>
+#include <algorithm>
+#include "pico_sim.hpp"
+#include "spi_dma.h"
+#include "i2c_dma.h"
+
+#define NUM_GPIOS 30
+
+spi_inst_t sim_spi_units[2] = { { 0, 0 }, { 1, 0 } };
+i2c_inst_t sim_i2c_units[2] = { { 0, 0 }, { 1, 0 } };
+
+static uint64_t now_us = 0;
+
+struct Alarm {
+    alarm_id_t       id;
+    absolute_time_t  time;
+    alarm_callback_t callback;
+    void            *user_data;
+};
+static std::vector<Alarm> alarms;
+static alarm_id_t next_alarm_id = 1;
+
+struct Attachment {
+    spi_inst_t   *spi;
+    uint          cs_pin;
+    SimSPIDevice *device;
+    bool          selected;     // select() called, deselect() not yet
+};
+static std::vector<Attachment> attachments;
+
+struct I2CAttachment {
+    i2c_inst_t   *i2c;
+    uint8_t       addr;
+    SimI2CDevice *device;
+};
+static std::vector<I2CAttachment> i2c_attachments;
+
+static bool gpio_level[NUM_GPIOS];
+
+// time and alarms
+
+uint64_t time_us_64(void) {
+    return now_us;
+}
+
+// fires the alarms up to target in their order, then sets the time
+void sim_advance_us(uint64_t us) {
+    uint64_t target = now_us + us;
+    for (;;) {
+        auto next = std::min_element(alarms.begin(), alarms.end(),
+                                     [](const Alarm &a, const Alarm &b) { return a.time < b.time; });
+        if (next == alarms.end() || next->time > target)
+            break;
+        Alarm alarm = *next;
+        alarms.erase(next);
+        if (alarm.time > now_us)
+            now_us = alarm.time;
+        int64_t again = alarm.callback(alarm.id, alarm.user_data);
+        if (again != 0) // SDK: > 0 after the callback was called, < 0 after the alarm time
+            alarms.push_back({ alarm.id, (again < 0) ? alarm.time - again : now_us + again,
+                               alarm.callback, alarm.user_data });
+    }
+    now_us = target;
+}
+
+void sleep_until(absolute_time_t target) {
+    if (target > now_us)
+        sim_advance_us(target - now_us);
+}
+
+void sleep_us(uint64_t us) {
+    sim_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms) {
+    sim_advance_us(ms * 1000ull);
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    if (time <= now_us) {
+        if (!fire_if_past)
+            return 0;
+        time = now_us;
+    }
+    alarm_id_t id = next_alarm_id++;
+    alarms.push_back({ id, time, callback, user_data });
+    return id;
+}
+
+bool cancel_alarm(alarm_id_t id) {
+    auto it = std::find_if(alarms.begin(), alarms.end(), [id](const Alarm &a) { return a.id == id; });
+    if (it == alarms.end())
+        return false;
+    alarms.erase(it);
+    return true;
+}
+
+// GPIO: chip select of the attached devices
+
+void gpio_init(uint gpio) {
+    if (gpio < NUM_GPIOS) gpio_level[gpio] = false;
+}
+
+void gpio_set_function(uint, enum gpio_function) {
+}
+
+void gpio_set_dir(uint, bool) {
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio >= NUM_GPIOS || gpio_level[gpio] == value)
+        return;
+    gpio_level[gpio] = value;
+    for (Attachment &a : attachments) {
+        if (a.cs_pin != gpio || a.selected == !value) continue;
+        a.selected = !value;
+        if (value) a.device->deselect();
+        else       a.device->select();
+    }
+}
+
+bool gpio_get(uint gpio) {
+    return gpio < NUM_GPIOS && gpio_level[gpio];
+}
+
+void sim_attach_spi(spi_inst_t *spi, uint cs_pin, SimSPIDevice *device) {
+    attachments.push_back({ spi, cs_pin, device, false });
+}
+
+void sim_detach_spi(SimSPIDevice *device) {
+    attachments.erase(std::remove_if(attachments.begin(), attachments.end(),
+                                     [device](const Attachment &a) { return a.device == device; }),
+                      attachments.end());
+}
+
+// SPI
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+    return spi_set_baudrate(spi, baudrate);
+}
+
+void spi_deinit(spi_inst_t *spi) {
+    spi->baudrate = 0;
+}
+
+uint spi_set_baudrate(spi_inst_t *spi, uint baudrate) {
+    spi->baudrate = baudrate;
+    return baudrate;
+}
+
+uint spi_get_baudrate(const spi_inst_t *spi) {
+    return spi->baudrate;
+}
+
+// one byte on the bus; a floating MISO line reads as 0xff. A chip
+// select pin that was never driven high is low, like a pin of the
+// RP2040 with its pull-down after reset: its device takes part.
+// The time of a byte is kept in ns, fast clocks need less than 1 us
+static uint8_t spi_transfer(spi_inst_t *spi, uint8_t mosi) {
+    static uint64_t spi_ns = 0;
+    uint8_t miso = 0xff;
+    for (Attachment &a : attachments) {
+        if (a.spi != spi || gpio_level[a.cs_pin])
+            continue;
+        if (!a.selected) {
+            a.selected = true;
+            a.device->select();
+        }
+        miso &= a.device->transfer(mosi);
+    }
+    if (spi->baudrate) {
+        spi_ns += (8000000000ull + spi->baudrate - 1) / spi->baudrate;
+        sim_advance_us(spi_ns / 1000);
+        spi_ns %= 1000;
+    }
+    return miso;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        spi_transfer(spi, src[i]);
+    return (int) len;
+}
+
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        dst[i] = spi_transfer(spi, repeated_tx_data);
+    return (int) len;
+}
+
+int spi_write_read_blocking(spi_inst_t *spi, const uint8_t *src, uint8_t *dst, size_t len) {
+    for (size_t i = 0; i < len; i++)
+        dst[i] = spi_transfer(spi, src[i]);
+    return (int) len;
+}
+
+// I2C
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t *i2c) {
+    i2c->baudrate = 0;
+}
+
+void sim_attach_i2c(i2c_inst_t *i2c, uint8_t addr, SimI2CDevice *device) {
+    i2c_attachments.push_back({ i2c, addr, device });
+}
+
+void sim_detach_i2c(SimI2CDevice *device) {
+    i2c_attachments.erase(std::remove_if(i2c_attachments.begin(), i2c_attachments.end(),
+                                         [device](const I2CAttachment &a) { return a.device == device; }),
+                          i2c_attachments.end());
+}
+
+// address byte plus len bytes, 9 clocks each (8 bits and the acknowledge)
+static SimI2CDevice *i2c_transfer(i2c_inst_t *i2c, uint8_t addr, size_t len) {
+    if (i2c->baudrate)
+        sim_advance_us((9000000ull * (len + 1) + i2c->baudrate - 1) / i2c->baudrate);
+    for (I2CAttachment &a : i2c_attachments) {
+        if (a.i2c == i2c && a.addr == addr)
+            return a.device;
+    }
+    return NULL;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    SimI2CDevice *device = i2c_transfer(i2c, addr, len);
+    if (!device)
+        return PICO_ERROR_GENERIC;
+    device->write(src, len, nostop);
+    return (int) len;
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop) {
+    SimI2CDevice *device = i2c_transfer(i2c, addr, len);
+    if (!device)
+        return PICO_ERROR_GENERIC;
+    device->read(dst, len, nostop);
+    return (int) len;
+}
+
+// SPI DMA transport (spi_dma.h): completes before it returns
+
+int SPIDMAInit(SPIDMA *pDMA, spi_inst_t *spi, int iCSPin) {
+    pDMA->spi = spi;
+    pDMA->iTxChan = 0;
+    pDMA->iRxChan = 1;
+    pDMA->iCSPin = iCSPin;
+    pDMA->bBusy = 0;
+    return 0;
+}
+
+void SPIDMAFree(SPIDMA *pDMA) {
+    pDMA->iTxChan = pDMA->iRxChan = -1;
+}
+
+int SPIDMAStart(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen) {
+    if (pDMA->iTxChan < 0 || iLen <= 0)
+        return -1;
+    if (pDMA->iCSPin >= 0)
+        gpio_put(pDMA->iCSPin, 0);
+    for (int i = 0; i < iLen; i++) {
+        uint8_t miso = spi_transfer(pDMA->spi, pTx ? pTx[i] : 0);
+        if (pRx) pRx[i] = miso;
+    }
+    if (pDMA->iCSPin >= 0)
+        gpio_put(pDMA->iCSPin, 1);
+    return 0;
+}
+
+int SPIDMABusy(SPIDMA *) {
+    return 0;
+}
+
+void SPIDMAWait(SPIDMA *) {
+}
+
+int SPIDMATransfer(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen) {
+    return SPIDMAStart(pDMA, pTx, pRx, iLen);
+}
+
+// I2C DMA transport (i2c_dma.h): completes before it returns,
+// one transaction per word with I2CDMA_STOP
+
+int I2CDMAInit(I2CDMA *pDMA, BBI2C *pBus) {
+    pDMA->pBus = pBus;
+    pDMA->iChan = 2;
+    pDMA->bBusy = 0;
+    pDMA->bAbort = 0;
+    return 0;
+}
+
+void I2CDMAFree(I2CDMA *pDMA) {
+    pDMA->iChan = -1;
+}
+
+int I2CDMAStart(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen) {
+    if (pDMA->iChan < 0 || pWords == NULL || iLen <= 0)
+        return -1;
+    std::vector<uint8_t> transaction;
+    pDMA->bAbort = 0;
+    for (int i = 0; i < iLen; i++) {
+        transaction.push_back((uint8_t) pWords[i]);
+        if ((pWords[i] & I2CDMA_STOP) || i == iLen - 1) {
+            if (i2c_write_blocking(pDMA->pBus->picoI2C, iAddr, transaction.data(), transaction.size(), false) < 0) {
+                pDMA->bAbort = 1;
+                break;
+            }
+            transaction.clear();
+        }
+    }
+    return 0;
+}
+
+int I2CDMABusy(I2CDMA *) {
+    return 0;
+}
+
+int I2CDMAWait(I2CDMA *pDMA) {
+    return pDMA->bAbort ? -1 : 0;
+}
+
+int I2CDMATransfer(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen) {
+    if (I2CDMAStart(pDMA, iAddr, pWords, iLen) != 0)
+        return -1;
+    return I2CDMAWait(pDMA);
+}
@@ -0,0 +1,54 @@
+/*
+ Simulated Pico for host builds: the headers in this directory stand
+ in for the Pico SDK, so that drivers like the BME280 class compile
+ and run on a PC against device models.
+
+ Time is simulated. It starts at 0 and advances by sleep_*() and by
+ bus transfers; alarms fire as it passes them. SPI devices are
+ attached to a unit and a chip select pin, gpio_put() on that pin
+ selects and deselects them. I2C devices are attached to a unit and
+ an address. The DMA transports of spi_dma.h and i2c_dma.h are
+ replaced by blocking transfers with the same effect on the bus.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/i2c.h"
+
+// a device on a simulated SPI bus
+class SimSPIDevice {
+public:
+    virtual ~SimSPIDevice() {}
+    // chip select went low: a transaction starts
+    virtual void    select() = 0;
+    // full duplex: the byte sent by the master, returns the one sent back
+    virtual uint8_t transfer(uint8_t mosi) = 0;
+    // chip select went high: the transaction ends
+    virtual void    deselect() = 0;
+};
+
+// a device on a simulated I2C bus
+class SimI2CDevice {
+public:
+    virtual ~SimI2CDevice() {}
+    // a write transfer after the address byte; nostop: a repeated start follows
+    virtual void    write(const uint8_t *data, size_t len, bool nostop) = 0;
+    // a read transfer after the address byte
+    virtual void    read(uint8_t *data, size_t len, bool nostop) = 0;
+};
+
+// attach a device to an SPI unit; cs_pin selects it (active low)
+void sim_attach_spi(spi_inst_t *spi, uint cs_pin, SimSPIDevice *device);
+void sim_detach_spi(SimSPIDevice *device);
+// attach a device to an I2C unit at a 7 bit address
+void sim_attach_i2c(i2c_inst_t *i2c, uint8_t addr, SimI2CDevice *device);
+void sim_detach_i2c(SimI2CDevice *device);
+
+// advance the simulated time without a sleep call, e.g. for code
+// that runs between sensor accesses
+void sim_advance_us(uint64_t us);
@@ -0,0 +1,183 @@
+/*
+ Model of an SSD1306 (or SH1106) OLED controller, see ssd1306_model.hpp.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <string.h>
+#include "ssd1306_model.hpp"
+
+SSD1306Model::SSD1306Model(int width, int height, bool sh1106)
+    : width(width), height(height), sh1106(sh1106), columns(sh1106 ? 132 : 128), dc_pin(0),
+      display_on(false), contrast(0x7f), start_line(0), scrolling(false), addressing(PAGE),
+      page(0), column(0), column_start(0), column_end(127), page_start(0), page_end(7),
+      command_len(0), command_expected(0) {
+    memset(this->ram, 0, sizeof(this->ram));
+    clear_stats();
+}
+
+void SSD1306Model::clear_stats() {
+    memset(&this->stats, 0, sizeof(this->stats));
+}
+
+bool SSD1306Model::matches(const uint8_t *buffer, int column_offset) const {
+    for (int p = 0; p < this->height / 8; p++) {
+        if (memcmp(&this->ram[p * this->columns + column_offset], &buffer[p * this->width], this->width))
+            return false;
+    }
+    return true;
+}
+
+// length of a command including its arguments (datasheet, section 9)
+int SSD1306Model::command_length(uint8_t cmd) {
+    switch (cmd) {
+        case 0x26: case 0x27:               // horizontal scroll setup
+            return 7;
+        case 0x29: case 0x2a:               // vertical and horizontal scroll setup
+            return 6;
+        case 0x21: case 0x22:               // column and page range
+        case 0xa3:                          // vertical scroll area
+            return 3;
+        case 0x20:                          // memory addressing mode
+        case 0x81: case 0x8d: case 0xa8: case 0xad: case 0xd3:
+        case 0xd5: case 0xd8: case 0xd9: case 0xda: case 0xdb:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+void SSD1306Model::write(const uint8_t *data, size_t len, bool) {
+    this->stats.transactions++;
+    this->stats.bytes += len;
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = data[i++];
+        bool    single  = control & 0x80;   // Co bit: one byte, then a control byte
+        bool    is_data = control & 0x40;   // D/C# bit
+        size_t  end     = single ? (i + 1 < len ? i + 1 : len) : len;
+        for (; i < end; i++) {
+            if (is_data)
+                data_byte(data[i]);
+            else
+                command_byte(data[i]);
+        }
+    }
+}
+
+// status: bit 6 set while the display is off; the low bits tell
+// the controllers apart (ss_oled reads them to detect the type)
+void SSD1306Model::read(uint8_t *data, size_t len, bool) {
+    this->stats.transactions++;
+    this->stats.bytes += len;
+    memset(data, (this->display_on ? 0x00 : 0x40) | (this->sh1106 ? 0x08 : 0x06), len);
+}
+
+void SSD1306Model::select() {
+    this->stats.transactions++;
+}
+
+// the SSD1306 has no output on SPI
+uint8_t SSD1306Model::transfer(uint8_t mosi) {
+    this->stats.bytes++;
+    if (gpio_get(this->dc_pin))
+        data_byte(mosi);
+    else
+        command_byte(mosi);
+    return 0xff;
+}
+
+void SSD1306Model::command_byte(uint8_t byte) {
+    this->stats.command_bytes++;
+    if (this->command_len == 0)
+        this->command_expected = command_length(byte);
+    this->command[this->command_len++] = byte;
+    if (this->command_len == this->command_expected) {
+        execute();
+        this->command_len = 0;
+    }
+}
+
+void SSD1306Model::execute() {
+    uint8_t cmd = this->command[0];
+    if (cmd < 0x10) {
+        this->column = (this->column & 0xf0) | cmd;
+    }
+    else
+    if (cmd < 0x20) {
+        this->column = (this->column & 0x0f) | ((cmd & 0x0f) << 4);
+    }
+    else
+    if (cmd >= 0xb0 && cmd <= 0xb7) {
+        this->page = cmd & 0x07;
+    }
+    else
+    if (cmd >= 0x40 && cmd <= 0x7f) {
+        this->start_line = cmd & 0x3f;
+    }
+    else
+    if (this->sh1106) {
+        // the SH1106 knows page addressing only; 0xAE/0xAF and contrast
+        // are common to both controllers
+        if (cmd == 0xae || cmd == 0xaf) this->display_on = cmd & 1;
+        if (cmd == 0x81) this->contrast = this->command[1];
+    }
+    else {
+        switch (cmd) {
+            case 0x20:
+                this->addressing = (ADDRESSING) (this->command[1] & 0x03);
+                if (this->addressing > PAGE) this->addressing = PAGE;
+                break;
+            case 0x21:
+                this->column_start = this->column = this->command[1] & 0x7f;
+                this->column_end   = this->command[2] & 0x7f;
+                break;
+            case 0x22:
+                this->page_start = this->page = this->command[1] & 0x07;
+                this->page_end   = this->command[2] & 0x07;
+                break;
+            case 0x81:
+                this->contrast = this->command[1];
+                break;
+            case 0xae: case 0xaf:
+                this->display_on = cmd & 1;
+                break;
+            case 0x2e: case 0x2f:
+                this->scrolling = cmd & 1;
+                break;
+        }
+    }
+}
+
+// the address pointer advances according to the addressing mode (section 10.1.3)
+void SSD1306Model::data_byte(uint8_t byte) {
+    this->stats.data_bytes++;
+    if (this->scrolling)
+        this->stats.scroll_data_bytes++;
+    if (this->column < this->columns)
+        this->ram[this->page * this->columns + this->column] = byte;
+    switch (this->addressing) {
+        case PAGE:
+            this->column = this->column < this->columns - 1 ? this->column + 1 : 0;
+            break;
+        case HORIZONTAL:
+            if (this->column < this->column_end) {
+                this->column++;
+            }
+            else {
+                this->column = this->column_start;
+                this->page   = this->page < this->page_end ? this->page + 1 : this->page_start;
+            }
+            break;
+        case VERTICAL:
+            if (this->page < this->page_end) {
+                this->page++;
+            }
+            else {
+                this->page   = this->page_start;
+                this->column = this->column < this->column_end ? this->column + 1 : this->column_start;
+            }
+            break;
+    }
+}
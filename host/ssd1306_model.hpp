@@ -0,0 +1,100 @@
+/*
+ Model of an SSD1306 (or SH1106) OLED controller on a simulated I2C
+ bus (see sim/pico_sim.hpp), so the ss_oled library runs on a host:
+
+   SSD1306Model panel(128, 64);
+   sim_attach_i2c(i2c0, 0x3c, &panel);
+   picoSSOLED oled(OLED_128x64, 0x3c, 0, 0, i2c0, 4, 5, 100 * 1000);
+
+ Each write transfer starts with control bytes (datasheet, section
+ 8.1.5): 0x00 for a stream of commands, 0x40 for a stream of display
+ data, 0x80 and 0xC0 for a single command or data byte followed by
+ another control byte. The model decodes the commands that address
+ the display RAM (page, column, memory addressing mode, column and page
+ range, start line) and skips the arguments of the others, so the RAM
+ holds what the panel would show. Of the hardware scroll only the
+ activation is kept (the RAM does not move). Reads return the status byte.
+
+ On 4-wire SPI there are no control bytes, the D/C pin tells commands
+ (low) from display data (high):
+
+   sim_attach_spi(spi0, 17, &panel);
+   panel.set_dc_pin(20);
+   picoSSOLED oled(OLED_128x64, 0, 0, spi0, 18, 19, 17, 20, 21, 10000000);
+
+ The model counts the transfers and bytes on the bus, so the
+ efficiency of the library can be measured.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "pico_sim.hpp"
+
+class SSD1306Model : public SimI2CDevice, public SimSPIDevice {
+public:
+    // bus usage since construction or clear_stats()
+    struct Stats {
+        uint32_t transactions;      // write transfers (I2C: start ... stop, SPI: chip select low)
+        uint32_t bytes;             // bytes after the address byte, control bytes included
+        uint32_t data_bytes;        // bytes written to the display RAM
+        uint32_t scroll_data_bytes; // of these while a scroll was active (not allowed)
+        uint32_t command_bytes;     // commands and their arguments
+    };
+
+    // sh1106: 132 columns, page addressing only (no commands 0x20 ... 0x22)
+    SSD1306Model(int width, int height, bool sh1106 = false);
+
+    const Stats &get_stats() const { return stats; }
+    void clear_stats();
+    // SPI: the gpio of the D/C pin
+    void set_dc_pin(uint pin) { dc_pin = pin; }
+    bool is_on() const { return display_on; }
+    uint8_t get_contrast() const { return contrast; }
+    uint8_t get_start_line() const { return start_line; }
+    bool is_scrolling() const { return scrolling; }
+    // display RAM, page after page, as ss_oled keeps its back buffer
+    const uint8_t *get_ram() const { return ram; }
+    // the visible part of the RAM equals a back buffer of width x height / 8 bytes;
+    // column_offset: the column of RAM that holds x = 0
+    bool matches(const uint8_t *buffer, int column_offset = 0) const;
+
+    // SimI2CDevice
+    void write(const uint8_t *data, size_t len, bool nostop) override;
+    void read(uint8_t *data, size_t len, bool nostop) override;
+
+    // SimSPIDevice
+    void    select() override;
+    uint8_t transfer(uint8_t mosi) override;
+    void    deselect() override {}
+
+private:
+    enum ADDRESSING { HORIZONTAL = 0, VERTICAL = 1, PAGE = 2 };
+
+    int         width, height;
+    bool        sh1106;
+    int         columns;            // RAM width
+    uint        dc_pin;
+    uint8_t     ram[132 * 8];
+    Stats       stats;
+
+    bool        display_on;
+    uint8_t     contrast;
+    uint8_t     start_line;
+    bool        scrolling;
+    ADDRESSING  addressing;
+    int         page, column;
+    int         column_start, column_end, page_start, page_end;
+
+    // command decoding
+    uint8_t     command[8];
+    int         command_len;        // bytes of the current command received
+    int         command_expected;   // its length including arguments
+
+    void        command_byte(uint8_t byte);
+    void        execute();
+    void        data_byte(uint8_t byte);
+    static int  command_length(uint8_t cmd);
+};
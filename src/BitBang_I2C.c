@@ -21,6 +21,7 @@
 #include "hardware/gpio.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/sync.h"
 
 #include "BitBang_I2C.h"
 
@@ -38,6 +39,12 @@
 void I2CInit(BBI2C *pI2C, uint32_t iClock)
 {
 	if (pI2C == NULL) return;
+	// several devices may initialise the same bus
+	if (!recursive_mutex_is_initialized(&pI2C->lock))
+	{
+	    recursive_mutex_init(&pI2C->lock);
+	    pI2C->bDMABusy = 0;
+	}
 	if ((pI2C->iSDA + 2 * i2c_hw_index(pI2C->picoI2C))%4 != 0) return ;
 	if ((pI2C->iSCL + 3 + 2 * i2c_hw_index(pI2C->picoI2C))%4 != 0) return ;
       i2c_init(pI2C->picoI2C, iClock);
@@ -47,6 +54,21 @@ void I2CInit(BBI2C *pI2C, uint32_t iClock)
       gpio_pull_up(pI2C->iSCL);
       return;
 }
+//
+// Reserve / release the bus for the calling core
+//
+void I2CLock(BBI2C *pI2C)
+{
+    recursive_mutex_enter_blocking(&pI2C->lock);
+    while (pI2C->bDMABusy) // the completion interrupt clears it
+        __wfe();
+} /* I2CLock() */
+
+void I2CUnlock(BBI2C *pI2C)
+{
+    recursive_mutex_exit(&pI2C->lock);
+} /* I2CUnlock() */
+
 //
 // Test a specific I2C address to see if a device responds
 // returns 0 for no response, 1 for a response
@@ -55,7 +77,9 @@ uint8_t I2CTest(BBI2C *pI2C, uint8_t addr)
 {
 	int ret;
     uint8_t rxdata;
+    I2CLock(pI2C);
     ret = i2c_read_blocking(pI2C->picoI2C, addr, &rxdata, 1, false);
+    I2CUnlock(pI2C);
     return (ret >= 0);
 } /* I2CTest() */
 
@@ -88,7 +112,10 @@ int I2CWrite(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
 {
 	int rc = 0;
 
-    rc = i2c_write_blocking(pI2C->picoI2C, iAddr, pData, iLen, true); // true to keep master control of bus
+    // end with a STOP: the next transaction may address another device
+    I2CLock(pI2C);
+    rc = i2c_write_blocking(pI2C->picoI2C, iAddr, pData, iLen, false);
+    I2CUnlock(pI2C);
     return rc >= 0 ? iLen : 0;
 
 
@@ -101,10 +128,12 @@ int I2CReadRegister(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Register, uint8_t *pDa
 {
 	int rc;
   
+    I2CLock(pI2C); // register address and data form one transaction
     rc = i2c_write_blocking(pI2C->picoI2C, iAddr, &u8Register, 1, true); // true to keep master control of bus 
     if (rc >= 0) {
         rc = i2c_read_blocking(pI2C->picoI2C, iAddr, pData, iLen, false);
     }
+    I2CUnlock(pI2C);
     return (rc >= 0);
 } /* I2CReadRegister() */
 
@@ -114,7 +143,9 @@ int I2CReadRegister(BBI2C *pI2C, uint8_t iAddr, uint8_t u8Register, uint8_t *pDa
 int I2CRead(BBI2C *pI2C, uint8_t iAddr, uint8_t *pData, int iLen)
 {
 	int rc;
+    I2CLock(pI2C);
     rc = i2c_read_blocking(pI2C->picoI2C, iAddr, pData, iLen, false);
+    I2CUnlock(pI2C);
     return (rc >= 0);
 	
 } /* I2CRead() */
@@ -21,6 +21,7 @@
 #define __BITBANG_I2C__
 
 #include "pico/stdlib.h"
+#include "pico/mutex.h"
 #include "hardware/i2c.h"
 
 // supported devices
@@ -68,6 +69,8 @@ typedef struct mybbi2c
 {
 uint8_t iSDA, iSCL; // pin numbers (0xff = disabled)
 i2c_inst_t * picoI2C; // used  pico I2C
+recursive_mutex_t lock; // serialises the devices sharing the bus
+volatile uint8_t bDMABusy; // a DMA transfer (i2c_dma.h) is in progress
 } BBI2C;
 
 #ifdef __cplusplus
@@ -107,6 +110,15 @@ void I2CScan(BBI2C *pI2C, uint8_t *pMap);
 //
 void I2CInit(BBI2C *pI2C, uint32_t iClock);
 //
+// Reserve the bus for a sequence of transactions (e.g. a display
+// update) so that other devices on the bus cannot interleave.
+// Every function above takes the lock for its own transaction,
+// the lock may be taken again by the same core.
+// I2CLock() also waits (WFE) until a DMA transfer on the bus has completed.
+//
+void I2CLock(BBI2C *pI2C);
+void I2CUnlock(BBI2C *pI2C);
+//
 // Figure out what device is at that address
 // returns the enumerated value
 //
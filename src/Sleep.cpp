@@ -12,7 +12,10 @@
 #include "hardware/clocks.h"
 #include "hardware/rosc.h"
 #include "hardware/structs/scb.h"
+#include "hardware/sync.h"
 #include "hardware/pll.h"
+#include "hardware/rtc.h"
+#include "hardware/gpio.h"
 
 
 // configure for SLEEP mode
@@ -61,6 +64,40 @@ void Sleep::configure(std::function<void()> setup, std::function<void()> loop) {
     _setup      = setup;   
 }
 
+// hook: function called right before each sleep phase
+void Sleep::set_sleep_hook(std::function<void()> hook) {
+    _sleep_hook = hook;
+}
+
+// hold: sleep for hold_ms after loop(), then call on_end
+void Sleep::hold(uint32_t hold_ms, std::function<void()> on_end) {
+    _hold_ms  = hold_ms;
+    _hold_end = on_end;
+}
+
+// time since boot plus the time spent in SLEEP mode
+uint64_t Sleep::now_us() const {
+    return time_us_64() + _slept_us;
+}
+
+// seconds since the start of the month; enough for the
+// sleep periods of up to 59 minutes 59 seconds used here
+static int64_t seconds_of(const datetime_t &t) {
+    return ((int64_t)t.day * 24 + t.hour) * 3600 + t.min * 60 + t.sec;
+}
+
+// the inverse of seconds_of() for the day of base; fields that
+// do not follow from the seconds are ignored by an RTC alarm
+static datetime_t datetime_at(const datetime_t &base, int64_t seconds) {
+    datetime_t t = base;
+    t.dotw = -1;
+    t.day  = seconds / 86400;
+    t.hour = seconds / 3600 % 24;
+    t.min  = seconds / 60 % 60;
+    t.sec  = seconds % 60;
+    return t;
+}
+
 // helper function to display frequencies of Pico system clocks
 void Sleep::measure_freqs(void) {
     uint f_pll_sys   = frequency_count_khz(CLOCKS_FC0_SRC_VALUE_PLL_SYS_CLKSRC_PRIMARY);
@@ -84,6 +121,52 @@ void Sleep::measure_freqs(void) {
     stdio_flush();
 }
 
+// low-power wait for a few milliseconds, woken by a timer alarm
+void Sleep::nap_until(absolute_time_t wakeup) {
+    uint scr = scb_hw->scr;
+    uint en0 = clocks_hw->sleep_en0;
+    uint en1 = clocks_hw->sleep_en1;
+
+    // while the core sleeps only the timer keeps running; the clocks
+    // return to their wake configuration as soon as the alarm fires
+    clocks_hw->sleep_en0 = 0;
+    clocks_hw->sleep_en1 = CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS;
+    scb_hw->scr = scr | M0PLUS_SCR_SLEEPDEEP_BITS;
+
+    while (!time_reached(wakeup)) {
+        best_effort_wfe_or_timeout(wakeup);
+    }
+
+    scb_hw->scr          = scr;
+    clocks_hw->sleep_en0 = en0;
+    clocks_hw->sleep_en1 = en1;
+}
+
+// low-power wait for a DMA transfer to an I2C unit, woken by its interrupt
+void Sleep::nap_while(std::function<bool()> busy) {
+    uint scr = scb_hw->scr;
+    uint en0 = clocks_hw->sleep_en0;
+    uint en1 = clocks_hw->sleep_en1;
+
+    clocks_hw->sleep_en0 = CLOCKS_SLEEP_EN0_CLK_SYS_DMA_BITS |
+                           CLOCKS_SLEEP_EN0_CLK_SYS_I2C0_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_I2C1_BITS |
+                           CLOCKS_SLEEP_EN0_CLK_SYS_BUSFABRIC_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_BUSCTRL_BITS |
+                           CLOCKS_SLEEP_EN0_CLK_SYS_SRAM0_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_SRAM1_BITS |
+                           CLOCKS_SLEEP_EN0_CLK_SYS_SRAM2_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_SRAM3_BITS;
+    clocks_hw->sleep_en1 = CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS |
+                           CLOCKS_SLEEP_EN1_CLK_SYS_SRAM4_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_SRAM5_BITS;
+    scb_hw->scr = scr | M0PLUS_SCR_SLEEPDEEP_BITS;
+
+    // an interrupt between busy() and __wfe() leaves the event set
+    while (busy()) {
+        __wfe();
+    }
+
+    scb_hw->scr          = scr;
+    clocks_hw->sleep_en0 = en0;
+    clocks_hw->sleep_en1 = en1;
+}
+
 // saves clock registers
 void Sleep::before_sleep() {
     _scb_orig = scb_hw->scr;
@@ -108,6 +191,8 @@ void Sleep::start_sleep() {
         rtc_init();
         rtc_set_datetime(&_init_time);
         sleep_goto_sleep_until(&_alarm_time, &onWakeUp);
+        // the RTC was reset to _init_time, so we slept exactly until _alarm_time
+        _slept_us += (seconds_of(_alarm_time) - seconds_of(_init_time)) * 1000000ull;
     } 
     else 
     if (_mode == MODE::DORMANT) { 
@@ -119,6 +204,68 @@ void Sleep::start_sleep() {
     }
 }
 
+static volatile bool hold_alarm;    // the RTC alarm at the end of the hold fired
+static volatile bool hold_extended; // the wake pin saw an edge during the hold
+
+static void onHoldAlarm() {
+    hold_alarm = true;
+}
+
+static void onHoldPin(uint, uint32_t) {
+    hold_extended = true;
+}
+
+// sleeps until the hold has expired: the crystal drives the RTC, whose
+// alarm wakes the core; in DORMANT mode the wake pin does so too and
+// moves the alarm to hold seconds from then. Only the RTC and the IO
+// bank keep their clocks.
+bool Sleep::hold_sleep() {
+    // the hold is timed from a fixed date: in DORMANT mode there
+    // is no _init_time, and an invalid datetime leaves the RTC off
+    datetime_t base = { .year = 2021, .month = 1, .day = 1, .dotw = 5, // a Friday
+                        .hour = 0, .min = 0, .sec = 0 };
+    int64_t hold_s = (_hold_ms + 999) / 1000;
+    int64_t start  = seconds_of(base);
+    int64_t end    = start + hold_s;
+    bool    pin    = (_mode == MODE::DORMANT);
+    datetime_t now;
+
+    sleep_run_from_xosc();
+    rtc_init();
+    if (!rtc_set_datetime(&base))
+        return false; // no alarm would ever end the hold
+    hold_extended = false;
+    if (pin) {
+        uint32_t events = _edge ? (_active ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL)
+                                : (_active ? GPIO_IRQ_LEVEL_HIGH : GPIO_IRQ_LEVEL_LOW);
+        gpio_set_irq_enabled_with_callback(_wakeup_pin, events, true, &onHoldPin);
+    }
+
+    clocks_hw->sleep_en0 = CLOCKS_SLEEP_EN0_CLK_RTC_RTC_BITS | (pin ? CLOCKS_SLEEP_EN0_CLK_SYS_IO_BITS : 0);
+    clocks_hw->sleep_en1 = 0;
+    scb_hw->scr = _scb_orig | M0PLUS_SCR_SLEEPDEEP_BITS;
+    for (;;) {
+        datetime_t alarm = datetime_at(base, end);
+        hold_alarm = false;
+        rtc_set_alarm(&alarm, &onHoldAlarm);
+        while (!hold_alarm && !hold_extended) {
+            __wfi();
+        }
+        if (!hold_extended)
+            break;
+        // button during the hold: show the display longer
+        hold_extended = false;
+        rtc_get_datetime(&now);
+        end = seconds_of(now) + hold_s;
+    }
+    rtc_disable_alarm();
+    if (pin)
+        gpio_set_irq_enabled(_wakeup_pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL |
+                                          GPIO_IRQ_LEVEL_HIGH | GPIO_IRQ_LEVEL_LOW, false);
+    _slept_us += (end - start) * 1000000ull;
+    return true;
+}
+
 // sleep recovery
 void Sleep::after_sleep() {
     // re-initialize clocks
@@ -136,6 +283,9 @@ void Sleep::after_sleep() {
 // Implementation of event loop
 // 1. _setup() is being executed
 // 2. the sleep functionality is executed
+//      0) a hold set by the previous _loop() is slept through
+//         and ended (if any)
+//      1) the sleep hook is called (if any)
 //      A) begin_sleep
 //      B) start_sleep
 //      C) after_sleep
@@ -143,7 +293,20 @@ void Sleep::after_sleep() {
 void Sleep::run() {
     _setup(); // called once
     while(true) {
+        if (_hold_ms) {
+            bool slept = false;
+            if (_mode != MODE::NORMAL) {
+                before_sleep();
+                slept = hold_sleep();
+                after_sleep();
+            }
+            if (!slept) // NORMAL mode, or the RTC did not start
+                nap_until(make_timeout_time_ms(_hold_ms));
+            _hold_ms = 0;
+            if (_hold_end) _hold_end();
+        }
         if (_mode != MODE::NORMAL) {
+            if (_sleep_hook) _sleep_hook();
             before_sleep();
             start_sleep(); 
             after_sleep(); // here _loop gets called in each iteration
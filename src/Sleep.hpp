@@ -10,6 +10,7 @@
 
 #include <functional>
 #include "pico/sleep.h"
+#include "pico/time.h"
 
 
 class Sleep {
@@ -44,6 +45,41 @@ public:
     }
 
     void measure_freqs();
+
+    // short low-power wait between two activities of the loop, e.g.
+    // while a sensor converts: the core sleeps (SLEEPDEEP + WFE) with
+    // all clocks gated except the system timer, and wakes up at
+    // the given time. Unlike SLEEP/DORMANT the clocks keep their
+    // configuration, so no recovery is needed afterwards.
+    // No DMA transfer or peripheral activity may be pending.
+    void nap_until(absolute_time_t wakeup);
+
+    // the same low-power wait for a DMA transfer to an I2C unit, e.g.
+    // a display flush (picoSSOLED::flush_start()): DMA, the I2C units,
+    // the bus fabric and the SRAM keep their clocks, the completion
+    // interrupt wakes the core. Returns when busy() returns false.
+    void nap_while(std::function<bool()> busy);
+
+    // hook called by run() right before the Pico enters SLEEP or
+    // DORMANT mode, e.g. to start a sensor conversion that completes
+    // while the Pico sleeps
+    void set_sleep_hook(std::function<void()> hook);
+
+    // hold, e.g. of the display, after loop() returned: run() sleeps
+    // for hold_ms with the RTC running (the Pico draws as in SLEEP
+    // mode) and calls on_end when the hold has expired, e.g. to turn
+    // the display off, before the regular sleep phase starts. In
+    // DORMANT mode an edge on the wake pin during the hold restarts it
+    // instead of starting the next loop(). In NORMAL mode the core naps
+    // (nap_until()), as it does if the RTC cannot be started. Set once
+    // per loop(); the resolution is 1 second.
+    void hold(uint32_t hold_ms, std::function<void()> on_end);
+
+    // microseconds since boot including the time spent in SLEEP mode
+    // (the system timer stops while the Pico sleeps). Time spent in
+    // DORMANT mode cannot be measured, since all clocks stop, and is
+    // not included.
+    uint64_t now_us() const;
     // kind of run shell: calls _setup once, and 
     // implements infinite loop where sleep phases
     // are initiated and _loop is being called
@@ -64,6 +100,11 @@ private:
     // sleep recovery: restores clock registers, re-enables ROSC 
     void after_sleep();
 
+    // sleeps through the hold set by hold(): until the RTC alarm at
+    // its end, restarted by edges on the wake pin (DORMANT mode).
+    // Returns false without sleeping if the RTC cannot be started.
+    bool hold_sleep();
+
     // private constructor
     Sleep() = default;   
 
@@ -86,6 +127,16 @@ private:
     datetime_t _init_time;    // initial time set
     datetime_t _alarm_time;   // alarm time
 
+    // time slept in SLEEP mode so far, in microseconds
+    uint64_t _slept_us = 0;
+
+    // user-defined hook called before each sleep phase
+    std::function<void()> _sleep_hook;
+
+    // pending hold and the function that ends it
+    uint32_t _hold_ms = 0;
+    std::function<void()> _hold_end;
+
     // references to user-defined setup() and loop() functions
     std::function<void()> _setup;   // user-defined setup function passed as lambda  - called once
     std::function<void()> _loop;    // user-defined loop function passed as lambda: called in each iteration
@@ -0,0 +1,117 @@
+/*
+ Class BME280Adaptive adapts the oversampling of a BME280
+ to the signal.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#include <math.h>
+#include "bme280_adaptive.hpp"
+
+// weight of a new value in the moving averages: 1/8
+#define EWMA_SHIFT 3
+
+BME280Adaptive::BME280Adaptive(BME280 &sensor)
+    : _sensor(sensor), _filter(sensor.get_filter()), _budget_us(0),
+      _reconfigurations(0), _last_sample_us(0) {
+    memset(_channels, 0, sizeof(_channels));
+    // datasheet noise with x1 oversampling: 0.005 C, 0.033 hPa, 0.02 %RH
+    set_thresholds(TEMPERATURE, 0.02f, 0.1f,  0.5f);
+    set_thresholds(PRESSURE,    0.05f, 0.15f, 0.5f);
+    set_thresholds(HUMIDITY,    0.1f,  0.5f,  2.0f);
+    _channels[TEMPERATURE].level = level_of(sensor.get_oversampling_t());
+    _channels[PRESSURE].level    = level_of(sensor.get_oversampling_p());
+    _channels[HUMIDITY].level    = level_of(sensor.get_oversampling_h());
+}
+
+// skipped channels are switched on with x1
+uint8_t BME280Adaptive::level_of(BME280::OVERSAMPLING osrs) {
+    if (osrs == BME280::OVERSAMPLING_SKIPPED) return 0;
+    if (osrs >= BME280::OVERSAMPLING_X16)     return NUM_LEVELS - 1;
+    return osrs - 1;
+}
+
+void BME280Adaptive::set_thresholds(CHANNEL channel, float flat, float noisy, float fast) {
+    _channels[channel].flat  = flat;
+    _channels[channel].noisy = noisy;
+    _channels[channel].fast  = fast;
+}
+
+// moving statistics of the change between two measurements
+// and the resulting oversampling level
+void BME280Adaptive::update(Channel &channel, float value) {
+    if (!channel.primed) {
+        channel.last   = value;
+        channel.primed = true;
+        return;
+    }
+    float delta = value - channel.last;
+    channel.last      = value;
+    channel.trend    += (delta - channel.trend) / (1 << EWMA_SHIFT);
+    float deviation   = delta - channel.trend;
+    channel.variance += (deviation * deviation - channel.variance) / (1 << EWMA_SHIFT);
+
+    float rate = fabsf(channel.trend);
+    if (channel.variance > channel.noisy * channel.noisy || rate > channel.fast) {
+        if (channel.level < NUM_LEVELS - 1) channel.level++;
+    }
+    else
+    if (channel.variance < channel.flat * channel.flat && rate < channel.flat) {
+        if (channel.level > 0) channel.level--;
+    }
+}
+
+void BME280Adaptive::apply_budget() {
+    if (_budget_us == 0) return;
+    // lower the least important channels first
+    static const CHANNEL order[] = { HUMIDITY, TEMPERATURE, PRESSURE };
+    for (CHANNEL c : order) {
+        while (_channels[c].level > 0 &&
+               BME280::conversion_time_max_us(_channels[TEMPERATURE].level + 1,
+                                              _channels[PRESSURE].level + 1,
+                                              _channels[HUMIDITY].level + 1) > _budget_us)
+            _channels[c].level--;
+    }
+}
+
+BME280::Measurement_t BME280Adaptive::measure() {
+    BME280::Measurement_t values = _sensor.measure();
+    if (_sensor.get_last_error() != PICO_OK)
+        return values;
+
+    // account the interval to the levels it was measured with
+    uint64_t now = _sensor.get_sample_time_us();
+    uint64_t elapsed = (_last_sample_us && now > _last_sample_us) ? now - _last_sample_us : 0;
+    _last_sample_us = now;
+    for (uint c = 0; c < NUM_CHANNELS; c++) {
+        _channels[c].time_us[_channels[c].level] += elapsed;
+        _channels[c].samples[_channels[c].level]++;
+    }
+
+    update(_channels[TEMPERATURE], values.temperature);
+    update(_channels[PRESSURE],    values.pressure);
+    update(_channels[HUMIDITY],    values.humidity);
+    apply_budget();
+
+    // the IIR filter smooths noise, but lags behind a trend
+    const Channel &p = _channels[PRESSURE];
+    BME280::FILTER filter = _filter;
+    if (fabsf(p.trend) > p.fast || p.variance < p.flat * p.flat)
+        filter = BME280::FILTER_OFF;
+    else
+    if (p.variance > p.noisy * p.noisy)
+        filter = BME280::FILTER_4;
+
+    bool changed = _sensor.set_oversampling((BME280::OVERSAMPLING) (_channels[TEMPERATURE].level + 1),
+                                            (BME280::OVERSAMPLING) (_channels[PRESSURE].level + 1),
+                                            (BME280::OVERSAMPLING) (_channels[HUMIDITY].level + 1));
+    if (filter != _filter) {
+        _sensor.set_filter(filter);
+        _filter = filter;
+        changed = true;
+    }
+    if (changed)
+        _reconfigurations++;
+    return values;
+}
@@ -0,0 +1,76 @@
+/*
+ Class BME280Adaptive adapts the oversampling of a BME280
+ to the signal: flat values are measured with x1 oversampling,
+ noisy values or fast changes raise the oversampling of the
+ affected channel, and noise without a trend switches on the
+ IIR filter. An optional budget caps the conversion time.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#pragma once
+
+#include "bme280_spi.hpp"
+
+
+class BME280Adaptive {
+public:
+    // channels of the sensor
+    enum CHANNEL { TEMPERATURE = 0, PRESSURE = 1, HUMIDITY = 2, NUM_CHANNELS = 3 };
+    // oversampling levels: level n means 2^n samples (x1 ... x16)
+    static const uint NUM_LEVELS = 5;
+
+    BME280Adaptive(BME280 &sensor);
+
+    // measure with the current settings, then adapt the settings
+    // for the next measurement
+    BME280::Measurement_t measure();
+
+    // thresholds of a channel in its unit (degrees, hPa, %RH),
+    // all relative to one measurement interval:
+    // flat:  noise and trend below this value lower the oversampling
+    // noisy: noise above this value raises the oversampling
+    // fast:  a trend above this value raises the oversampling
+    //        and turns the IIR filter off (it would lag behind)
+    void set_thresholds(CHANNEL channel, float flat, float noisy, float fast);
+
+    // maximum conversion time in microseconds (0 = unlimited); if the
+    // chosen levels exceed it, the least important channels
+    // (humidity, then temperature) are lowered first
+    void set_budget_us(uint32_t budget_us) { _budget_us = budget_us; }
+
+    // current oversampling level of a channel (0 = x1 ... 4 = x16)
+    uint get_level(CHANNEL channel) const { return _channels[channel].level; }
+    // time and number of measurements spent at a level
+    uint64_t get_time_us(CHANNEL channel, uint level) const { return _channels[channel].time_us[level]; }
+    uint32_t get_samples(CHANNEL channel, uint level) const { return _channels[channel].samples[level]; }
+    // number of measurements that changed the sensor configuration
+    uint32_t get_reconfigurations() const { return _reconfigurations; }
+
+private:
+    struct Channel {
+        float    flat, noisy, fast;     // thresholds
+        float    last;                  // previous value
+        float    trend;                 // moving average of the change per interval
+        float    variance;              // moving variance of the change around the trend
+        bool     primed;                // last is valid
+        uint8_t  level;                 // current oversampling level
+        uint64_t time_us[NUM_LEVELS];   // time spent at each level
+        uint32_t samples[NUM_LEVELS];   // measurements taken at each level
+    };
+
+    // feeds a new value and adjusts the level of the channel
+    void update(Channel &channel, float value);
+    // lowers levels until the conversion time fits the budget
+    void apply_budget();
+    // level of an oversampling register value
+    static uint8_t level_of(BME280::OVERSAMPLING osrs);
+
+    BME280  &_sensor;
+    Channel  _channels[NUM_CHANNELS];
+    BME280::FILTER _filter;
+    uint32_t _budget_us;
+    uint32_t _reconfigurations;
+    uint64_t _last_sample_us;
+};
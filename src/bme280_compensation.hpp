@@ -0,0 +1,80 @@
+/*
+ Compensation of BME280 adc values: the 32 bit integer routines
+ from the Bosch datasheet (section 4.2.3, appendix 8.2).
+
+ Header-only and without Pico SDK dependencies, so the same code
+ runs in the BME280 class and on a host (see host/bme280_batch.hpp).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+
+// trimming parameters from the registers 0x88 ... 0xA1 and 0xE1 ... 0xE7
+struct BME280Calibration {
+    uint16_t    dig_T1;
+    int16_t     dig_T2, dig_T3;
+    uint16_t    dig_P1;
+    int16_t     dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
+    uint8_t     dig_H1, dig_H3;
+    int8_t      dig_H6;
+    int16_t     dig_H2, dig_H4, dig_H5;
+};
+
+// temperature in 0.01 degrees celsius; t_fine is needed by the others
+static inline int32_t bme280_compensate_temperature(const BME280Calibration &c, int32_t adc_T, int32_t &t_fine) {
+    int32_t var1, var2, T;
+    var1 = ((((adc_T >> 3) - ((int32_t) c.dig_T1 << 1))) * ((int32_t) c.dig_T2)) >> 11;
+    var2 = (((((adc_T >> 4) - ((int32_t) c.dig_T1)) * ((adc_T >> 4) - ((int32_t) c.dig_T1))) >> 12) * ((int32_t) c.dig_T3))
+            >> 14;
+
+    t_fine = var1 + var2;
+    T = (t_fine * 5 + 128) >> 8;
+    return T;
+}
+
+// pressure in Pa
+static inline uint32_t bme280_compensate_pressure(const BME280Calibration &c, int32_t adc_P, int32_t t_fine) {
+    int32_t var1, var2;
+    uint32_t p;
+    var1 = (((int32_t) t_fine) >> 1) - (int32_t) 64000;
+    var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t) c.dig_P6);
+    var2 = var2 + ((var1 * ((int32_t) c.dig_P5)) << 1);
+    var2 = (var2 >> 2) + (((int32_t) c.dig_P4) << 16);
+    var1 = (((c.dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t) c.dig_P2) * var1) >> 1)) >> 18;
+    var1 = ((((32768 + var1)) * ((int32_t) c.dig_P1)) >> 15);
+    if (var1 == 0)
+        return 0;
+
+    p = (((uint32_t) (((int32_t) 1048576) - adc_P) - (var2 >> 12))) * 3125;
+    if (p < 0x80000000)
+        p = (p << 1) / ((uint32_t) var1);
+    else
+        p = (p / (uint32_t) var1) * 2;
+
+    var1 = (((int32_t) c.dig_P9) * ((int32_t) (((p >> 3) * (p >> 3)) >> 13))) >> 12;
+    var2 = (((int32_t) (p >> 2)) * ((int32_t) c.dig_P8)) >> 13;
+    p = (uint32_t) ((int32_t) p + ((var1 + var2 + c.dig_P7) >> 4));
+
+    return p;
+}
+
+// humidity in 1/1024 %RH
+static inline uint32_t bme280_compensate_humidity(const BME280Calibration &c, int32_t adc_H, int32_t t_fine) {
+    int32_t v_x1_u32r;
+    v_x1_u32r = (t_fine - ((int32_t) 76800));
+    v_x1_u32r = (((((adc_H << 14) - (((int32_t) c.dig_H4) << 20) - (((int32_t) c.dig_H5) * v_x1_u32r)) +
+                   ((int32_t) 16384)) >> 15) * (((((((v_x1_u32r * ((int32_t) c.dig_H6)) >> 10) * (((v_x1_u32r *
+                                                                                                  ((int32_t) c.dig_H3))
+            >> 11) + ((int32_t) 32768))) >> 10) + ((int32_t) 2097152)) *
+                                                 ((int32_t) c.dig_H2) + 8192) >> 14));
+    v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t) c.dig_H1)) >> 4));
+    v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
+    v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
+
+    return (uint32_t) (v_x1_u32r >> 12);
+}
@@ -0,0 +1,236 @@
+/*
+ Class BME280Derived computes values derived from a BME280
+ measurement with fixed-point arithmetic.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include "bme280_derived.hpp"
+
+// log2(1 + i / 128) in Q30
+static const uint32_t log2_table[129] = {
+             0,   12055174,   24017256,   35887675,   47667823,   59359063,
+      70962728,   82480119,   93912511,  105261148,  116527248,  127712004,
+     138816582,  149842124,  160789745,  171660541,  182455581,  193175914,
+     203822568,  214396548,  224898839,  235330407,  245692198,  255985140,
+     266210141,  276368092,  286459867,  296486323,  306448299,  316346620,
+     326182095,  335955515,  345667660,  355319292,  364911162,  374444004,
+     383918542,  393335482,  402695523,  411999347,  421247625,  430441017,
+     439580170,  448665721,  457698295,  466678506,  475606957,  484484242,
+     493310944,  502087636,  510814882,  519493235,  528123241,  536705435,
+     545240343,  553728485,  562170370,  570566499,  578917365,  587223455,
+     595485245,  603703206,  611877800,  620009483,  628098702,  636145900,
+     644151509,  652115959,  660039669,  667923055,  675766525,  683570481,
+     691335320,  699061430,  706749198,  714399001,  722011213,  729586201,
+     737124328,  744625951,  752091421,  759521085,  766915285,  774274358,
+     781598637,  788888448,  796144114,  803365955,  810554283,  817709409,
+     824831638,  831921271,  838978604,  846003931,  852997541,  859959719,
+     866890747,  873790901,  880660455,  887499680,  894308843,  901088206,
+     907838029,  914558569,  921250079,  927912807,  934547002,  941152905,
+     947730758,  954280797,  960803257,  967298370,  973766362,  980207461,
+     986621888,  993009864,  999371606, 1005707329, 1012017244, 1018301561,
+    1024560487, 1030794226, 1037002979, 1043186948, 1049346328, 1055481314,
+    1061592099, 1067678873, 1073741824,
+};
+
+// 2^(i / 128) in Q30
+static const uint32_t exp2_table[129] = {
+    1073741824, 1079572136, 1085434106, 1091327906, 1097253708, 1103211687,
+    1109202018, 1115224875, 1121280436, 1127368878, 1133490379, 1139645120,
+    1145833280, 1152055042, 1158310587, 1164600099, 1170923762, 1177281762,
+    1183674286, 1190101520, 1196563654, 1203060876, 1209593378, 1216161350,
+    1222764986, 1229404479, 1236080024, 1242791816, 1249540052, 1256324931,
+    1263146652, 1270005413, 1276901417, 1283834865, 1290805962, 1297814910,
+    1304861917, 1311947188, 1319070932, 1326233356, 1333434672, 1340675091,
+    1347954824, 1355274085, 1362633090, 1370032052, 1377471191, 1384950723,
+    1392470869, 1400031848, 1407633882, 1415277195, 1422962010, 1430688553,
+    1438457051, 1446267730, 1454120821, 1462016553, 1469955159, 1477936870,
+    1485961921, 1494030547, 1502142985, 1510299473, 1518500250, 1526745556,
+    1535035634, 1543370725, 1551751076, 1560176931, 1568648537, 1577166143,
+    1585730000, 1594340357, 1602997467, 1611701585, 1620452965, 1629251865,
+    1638098541, 1646993254, 1655936265, 1664927835, 1673968228, 1683057710,
+    1692196547, 1701385007, 1710623359, 1719911875, 1729250827, 1738640488,
+    1748081133, 1757573041, 1767116489, 1776711757, 1786359126, 1796058879,
+    1805811301, 1815616678, 1825475297, 1835387448, 1845353420, 1855373507,
+    1865448001, 1875577199, 1885761398, 1896000896, 1906295993, 1916646992,
+    1927054196, 1937517909, 1948038440, 1958616096, 1969251188, 1979944027,
+    1990694927, 2001504204, 2012372174, 2023299156, 2034285470, 2045331439,
+    2056437387, 2067603638, 2078830522, 2090118366, 2101467502, 2112878262,
+    2124350982, 2135885998, 2147483648,
+};
+
+// constants in Q24
+static const int32_t LOG2_E_Q24      = 24204406;   // log2(e)
+static const int32_t LN_2_Q24        = 11629080;   // ln(2)
+static const int32_t LOG2_611_2_Q24  = 155281535;  // log2(611.2 Pa), Magnus
+static const int32_t LOG2_100_RH_Q24 = 279237570;  // log2(100 %RH * 1024)
+static const int64_t SLP_EXPONENT_Q24 = 127242564; // 5.257 * log2(e)
+
+// Magnus coefficients over water: 17.62 * 65536 and 243.12 K in 0.01 K
+static const int64_t MAGNUS_B_Q16    = 1154744;
+static const int64_t MAGNUS_C        = 24312;
+
+// log2(x) in Q24, x > 0
+static int32_t log2_q24(uint32_t x) {
+    int n = 31 - __builtin_clz(x);
+    uint32_t frac = (x << (31 - n)) & 0x7fffffff; // mantissa bits below the leading one
+    uint32_t i = frac >> 24;
+    uint32_t rest = frac & 0xffffff;
+    uint32_t v = log2_table[i] + (uint32_t) (((uint64_t) (log2_table[i + 1] - log2_table[i]) * rest) >> 24);
+    return (n << 24) + (int32_t) (v >> 6);
+}
+
+// 2^y in Q30 for y in Q24, -30 < y < 34
+static uint64_t exp2_q30(int32_t y) {
+    int32_t n = y >> 24; // floor
+    uint32_t frac = y & 0xffffff;
+    uint32_t i = frac >> 17;
+    uint32_t rest = frac & 0x1ffff;
+    uint64_t v = exp2_table[i] + (((uint64_t) (exp2_table[i + 1] - exp2_table[i]) * rest) >> 17);
+    return (n >= 0) ? v << n : v >> -n;
+}
+
+static uint32_t isqrt(uint32_t x) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > x)
+        bit >>= 2;
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+            root >>= 1;
+        bit >>= 2;
+    }
+    return root;
+}
+
+// 17.62 * T / (243.12 + T) in Q16
+static int32_t magnus_q16(int32_t temperature) {
+    return (int32_t) (temperature * MAGNUS_B_Q16 / (MAGNUS_C + temperature));
+}
+
+BME280Derived::BME280Derived() {
+    this->temperature = 0;
+    this->humidity    = 0;
+    this->pressure    = 0;
+    this->elevation   = 0;
+    this->computed    = 0;
+}
+
+void BME280Derived::set_measurement(int32_t temperature, uint32_t humidity, uint32_t pressure) {
+    this->temperature = temperature;
+    this->humidity    = humidity;
+    this->pressure    = pressure;
+    this->computed    = 0;
+}
+
+void BME280Derived::set_elevation(int32_t elevation) {
+    this->elevation = elevation;
+    this->computed &= ~SEA_LEVEL_PRESSURE;
+}
+
+int32_t BME280Derived::dew_point() {
+    if (!(computed & DEW_POINT)) {
+        dew_point_value = compute_dew_point(temperature, humidity);
+        computed |= DEW_POINT;
+    }
+    return dew_point_value;
+}
+
+uint32_t BME280Derived::absolute_humidity() {
+    if (!(computed & ABSOLUTE_HUMIDITY)) {
+        absolute_humidity_value = compute_absolute_humidity(temperature, humidity);
+        computed |= ABSOLUTE_HUMIDITY;
+    }
+    return absolute_humidity_value;
+}
+
+int32_t BME280Derived::heat_index() {
+    if (!(computed & HEAT_INDEX)) {
+        heat_index_value = compute_heat_index(temperature, humidity);
+        computed |= HEAT_INDEX;
+    }
+    return heat_index_value;
+}
+
+uint32_t BME280Derived::sea_level_pressure() {
+    if (!(computed & SEA_LEVEL_PRESSURE)) {
+        sea_level_pressure_value = compute_sea_level_pressure(temperature, pressure, elevation);
+        computed |= SEA_LEVEL_PRESSURE;
+    }
+    return sea_level_pressure_value;
+}
+
+// Td = c * g / (b - g) with g = ln(RH / 100) + b * T / (c + T)
+int32_t BME280Derived::compute_dew_point(int32_t temperature, uint32_t humidity) {
+    if (humidity == 0)
+        humidity = 1; // the logarithm needs a value > 0
+    int64_t ln_rh = ((int64_t) (log2_q24(humidity) - LOG2_100_RH_Q24) * LN_2_Q24) >> 32; // Q16
+    int64_t gamma = ln_rh + magnus_q16(temperature);
+    return (int32_t) (MAGNUS_C * gamma / (MAGNUS_B_Q16 - gamma));
+}
+
+// AH = e / (Rw * T) with e = RH * 611.2 Pa * exp(b * T / (c + T)),
+// Rw = 461.5 J/(kg K), i.e. 2167 mg K / (m^3 Pa)
+uint32_t BME280Derived::compute_absolute_humidity(int32_t temperature, uint32_t humidity) {
+    int32_t y = (int32_t) (((int64_t) magnus_q16(temperature) * LOG2_E_Q24) >> 16) + LOG2_611_2_Q24;
+    uint64_t saturation = exp2_q30(y) >> 14;          // Pa in Q16
+    uint64_t vapour = saturation * humidity / 102400; // Pa in Q16
+    return (uint32_t) (((vapour * 216700 / (temperature + 27315)) + 0x8000) >> 16);
+}
+
+// Rothfusz regression coefficients in units of 1e-8
+static const int64_t ROTHFUSZ[9] = {
+    -4237900000LL, 204901523, 1014333127, -22475541, -683783, -5481717, 122874, 85282, -199
+};
+
+// NWS heat index in degrees fahrenheit, computed in hundredths
+int32_t BME280Derived::compute_heat_index(int32_t temperature, uint32_t humidity) {
+    int64_t t = (temperature * 18 + 5) / 10 + 3200;      // 0.01 degrees fahrenheit
+    int64_t r = ((int64_t) humidity * 100 + 512) >> 10;  // 0.01 %RH
+    // simple formula, sufficient below 80 degrees fahrenheit;
+    // decided in 0.001 degrees since the result jumps there
+    int64_t tm = temperature * 18 + 32000;           // exact
+    int64_t simple = (tm + 61000 + (tm - 68000) * 12 / 10 + ((int64_t) humidity * 94000 >> 10) / 1000) / 2;
+    int64_t hi = simple / 10;
+    if (simple + tm >= 160000) {
+        // all products scaled to hundredths
+        int64_t tt = t * t / 100, rr = r * r / 100, tr = t * r / 100;
+        int64_t ttr = tt * r / 100, trr = t * rr / 100, ttrr = tt * rr / 100;
+        hi = (ROTHFUSZ[0] * 100 + ROTHFUSZ[1] * t + ROTHFUSZ[2] * r + ROTHFUSZ[3] * tr
+            + ROTHFUSZ[4] * tt + ROTHFUSZ[5] * rr + ROTHFUSZ[6] * ttr + ROTHFUSZ[7] * trr
+            + ROTHFUSZ[8] * ttrr) / 100000000;
+        if (r < 1300 && t >= 8000 && t <= 11200) {
+            // dry air: - (13 - RH) / 4 * sqrt((17 - |T - 95|) / 17)
+            int64_t d = (t > 9500) ? t - 9500 : 9500 - t;
+            uint32_t root = isqrt((uint32_t) (((1700 - d) << 16) / 1700)); // Q8
+            hi -= ((1300 - r) / 4 * root) >> 8;
+        }
+        else if (r > 8500 && t >= 8000 && t <= 8700) {
+            // humid air: + (RH - 85) / 10 * (87 - T) / 5
+            hi += (r - 8500) * (8700 - t) / 5000;
+        }
+    }
+    return (int32_t) ((hi - 3200) * 5 / 9);
+}
+
+// p0 = p * (1 - L * h / (T + L * h + 273.15 K))^-5.257 with L = 0.0065 K/m,
+// i.e. p * (1 + u)^5.257 with u = L * h / T, T in K
+uint32_t BME280Derived::compute_sea_level_pressure(int32_t temperature, uint32_t pressure, int32_t elevation) {
+    int64_t kelvin = temperature + 27315;      // 0.01 K
+    int64_t lapse = (int64_t) elevation * 65;  // 1e-6 K
+    int64_t u = lapse * (1LL << 30) / (kelvin * 10000); // Q30, elevation may be negative
+    // u stays below 0.1, ln(1 + u) needs five terms of its series
+    int64_t ln = u / 5;
+    ln = (1LL << 30) / 4 - ((u * ln) >> 30);
+    ln = (1LL << 30) / 3 - ((u * ln) >> 30);
+    ln = (1LL << 30) / 2 - ((u * ln) >> 30);
+    ln = (1LL << 30) - ((u * ln) >> 30);
+    ln = (u * ln) >> 30;
+    int32_t y = (int32_t) ((ln * SLP_EXPONENT_Q24) >> 30); // log2((1 + u)^5.257) in Q24
+    return (uint32_t) ((pressure * exp2_q30(y) + (1u << 29)) >> 30);
+}
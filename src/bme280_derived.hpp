@@ -0,0 +1,64 @@
+/*
+ Class BME280Derived computes values derived from a BME280
+ measurement: dew point, absolute humidity, heat index and
+ pressure reduced to sea level.
+
+ Inputs and results are integers in the units of
+ BME280::MeasurementFixed_t, the computation uses fixed-point
+ approximations only. The class depends on stdint alone,
+ so it also compiles on a host (see host/).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include <stdint.h>
+
+class BME280Derived {
+public:
+    BME280Derived();
+
+    // new measurement: temperature in 0.01 degrees celsius,
+    // humidity in 1/1024 %RH, pressure in Pa.
+    // Invalidates the values computed so far.
+    void set_measurement(int32_t temperature, uint32_t humidity, uint32_t pressure);
+    // height of the sensor above sea level in cm, used by sea_level_pressure()
+    void set_elevation(int32_t elevation);
+
+    // The metrics are computed when asked for and cached
+    // until the next set_measurement().
+    // Errors are stated against the formulas in double precision
+    // for -40 to 85 degrees celsius and 1 to 100 %RH, measured by
+    // host/derived_bench.
+
+    // Magnus formula, 0.01 degrees celsius, error < 0.02 degrees
+    int32_t  dew_point();
+    // mass of water vapour in mg/m^3, error < 0.05 % or 1 mg/m^3
+    uint32_t absolute_humidity();
+    // NWS heat index (Rothfusz regression with its adjustments),
+    // 0.01 degrees celsius, error < 0.05 degrees up to a heat index of 70
+    int32_t  heat_index();
+    // barometric formula with 0.0065 K/m, Pa, error < 1 Pa up to 3000 m
+    uint32_t sea_level_pressure();
+
+    // the computations without caching
+    static int32_t  compute_dew_point(int32_t temperature, uint32_t humidity);
+    static uint32_t compute_absolute_humidity(int32_t temperature, uint32_t humidity);
+    static int32_t  compute_heat_index(int32_t temperature, uint32_t humidity);
+    static uint32_t compute_sea_level_pressure(int32_t temperature, uint32_t pressure, int32_t elevation);
+
+private:
+    enum METRIC { DEW_POINT = 0x1, ABSOLUTE_HUMIDITY = 0x2, HEAT_INDEX = 0x4, SEA_LEVEL_PRESSURE = 0x8 };
+
+    int32_t  temperature;   // 0.01 degrees celsius
+    uint32_t humidity;      // 1/1024 %RH
+    uint32_t pressure;      // Pa
+    int32_t  elevation;     // cm
+    uint8_t  computed;      // METRIC flags of the cached values
+    int32_t  dew_point_value;
+    uint32_t absolute_humidity_value;
+    int32_t  heat_index_value;
+    uint32_t sea_level_pressure_value;
+};
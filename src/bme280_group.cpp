@@ -0,0 +1,66 @@
+/*
+ Class BME280Group drives several BME280 sensors on one SPI bus.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#include "bme280_group.hpp"
+
+#ifndef BME280_USE_I2C // sensors with chip select on a shared SPI bus
+
+
+BME280Group::BME280Group(std::initializer_list<uint> cs_pins, uint spi_no, uint rx_pin, uint tx_pin,
+                         uint sck_pin, uint freq) {
+    this->spi_hw = (spi_no == 1) ? spi1 : spi0;
+    this->count  = 0;
+    // deselect every sensor before the first one is talked to
+    for (uint cs_pin : cs_pins) {
+        gpio_init(cs_pin);
+        gpio_set_dir(cs_pin, GPIO_OUT);
+        gpio_put(cs_pin, 1);
+    }
+    // initialize SPI access once for all sensors
+    spi_init(spi_hw, freq);
+    gpio_set_function(rx_pin, GPIO_FUNC_SPI);
+    gpio_set_function(sck_pin, GPIO_FUNC_SPI);
+    gpio_set_function(tx_pin, GPIO_FUNC_SPI);
+    // Make the SPI pins available to picotool
+    bi_decl(bi_3pins_with_func(rx_pin, tx_pin, sck_pin, GPIO_FUNC_SPI));
+}
+
+bool BME280Group::add(BME280 &sensor) {
+    if (count >= MAX_SENSORS)
+        return false;
+    sensors[count++] = &sensor;
+    return true;
+}
+
+absolute_time_t BME280Group::start_measurement() {
+    absolute_time_t done = get_absolute_time();
+    // a few us per sensor: the conversions run in parallel
+    for (uint i = 0; i < count; i++) {
+        absolute_time_t due = sensors[i]->start_measurement();
+        if (absolute_time_diff_us(done, due) > 0)
+            done = due;
+    }
+    return done;
+}
+
+uint BME280Group::collect() {
+    uint collected = 0;
+    for (uint i = 0; i < count; i++) {
+        BME280::Measurement_t values;
+        if (sensors[i]->try_collect(values))
+            collected++;
+    }
+    return collected;
+}
+
+uint BME280Group::measure() {
+    sleep_until(start_measurement());
+    // every conversion is due now, no status polling needed
+    return collect();
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ Class BME280Group drives several BME280 sensors on one SPI bus
+ (separate chip select pins). All sensors are triggered back to
+ back, so a group measurement takes about one conversion time
+ instead of one per sensor.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#pragma once
+
+#include <initializer_list>
+#include "bme280_spi.hpp"
+
+#ifndef BME280_USE_I2C // sensors with chip select on a shared SPI bus
+
+
+class BME280Group {
+public:
+    static const uint MAX_SENSORS = 4;
+
+    // initialises the SPI bus shared by the sensors and drives the
+    // chip select pins of all of them high. A sensor whose chip select
+    // is still low (after reset the pins are pulled down) would answer
+    // to the initialisation of the sensors constructed before it
+    BME280Group(std::initializer_list<uint> cs_pins,
+                uint spi_no    = 0,
+                uint rx_pin    = PICO_DEFAULT_SPI_RX_PIN,
+                uint tx_pin    = PICO_DEFAULT_SPI_TX_PIN,
+                uint sck_pin   = PICO_DEFAULT_SPI_SCK_PIN,
+                uint freq      = 500 * 1000);
+
+    // the bus for the sensors of the group, constructed after it:
+    //   BME280Group group({ 17, 20 });
+    //   BME280 indoor(group.get_spi(), 17), outdoor(group.get_spi(), 20);
+    //   group.add(indoor);
+    //   group.add(outdoor);
+    spi_inst_t *get_spi() const { return spi_hw; }
+    // adds a sensor on this bus, false if the group is full
+    bool add(BME280 &sensor);
+    uint size() const { return count; }
+    BME280 &get(uint index) { return *sensors[index]; }
+
+    // triggers a forced conversion on every sensor and returns the
+    // time at which all of them have completed
+    absolute_time_t start_measurement();
+    // reads and compensates every sensor whose conversion has
+    // completed (each sensor's measurement member), returns the
+    // number of sensors read
+    uint collect();
+    // start_measurement(), one wait for the longest conversion, collect()
+    uint measure();
+
+private:
+    spi_inst_t *spi_hw;
+    BME280     *sensors[MAX_SENSORS];
+    uint        count;
+};
+
+#endif
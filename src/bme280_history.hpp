@@ -0,0 +1,121 @@
+/*
+ Class template BME280History keeps the last N samples of a BME280
+ as raw adc values and compensates them only when they are read.
+
+ A record takes 8 bytes: the three adc values (20 + 20 + 16 bits)
+ and the seconds elapsed since the previous record. Compensation
+ runs in batches over the requested records and its results are
+ cached per record (another sizeof(BME280::MeasurementFixed_t)
+ bytes each), so repeated reads (display, alarm, export)
+ compensate every record only once.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license. 
+*/
+
+#pragma once
+
+#include "bme280_spi.hpp"
+
+
+template <uint N>
+class BME280History {
+public:
+    BME280History(BME280 &sensor) : sensor(sensor) {
+        head     = 0;
+        count    = 0;
+        chain_us = 0;
+        last_us  = 0;
+        memset(cached, 0, sizeof(cached));
+    }
+
+    // appends a sample from BME280::measure_raw(), the oldest
+    // record is dropped when the history is full. Returns false and
+    // keeps nothing if measure_raw() failed (time_us 0, no data) or
+    // the sample is older than the newest record.
+    bool append(const BME280::RawSample_t &sample) {
+        if (sample.time_us == 0 || (count > 0 && sample.time_us < last_us))
+            return false;
+        // the gap is rounded against the time the deltas give the
+        // previous record, so the rounding errors do not add up
+        uint64_t seconds = 0;
+        if (count > 0) {
+            int64_t gap = (int64_t) (sample.time_us - chain_us);
+            seconds = (gap > 0) ? (gap + 500000) / 1000000 : 0;
+        }
+        if (count == 0 || seconds > 255) { // the chain starts anew
+            seconds  = (seconds > 255) ? 255 : 0;
+            chain_us = sample.time_us;
+        }
+        else
+            chain_us += seconds * 1000000ull;
+        uint slot = (head + count) % N;
+        if (count == N) // overwrite the oldest
+            head = (head + 1) % N;
+        else
+            count++;
+        records[slot] = pack(sample.data, seconds);
+        cached[slot / 32] &= ~(1u << (slot % 32));
+        last_us = sample.time_us;
+        return true;
+    }
+
+    uint size() const { return count; }
+    void clear() { count = 0; }
+
+    // record index (0 = oldest) to values, compensates on first access;
+    // an index >= size() yields values with valid == 0
+    const BME280::MeasurementFixed_t &get(uint index) {
+        if (index >= count)
+            return none;
+        compensate(index, 1);
+        return values[(head + index) % N];
+    }
+
+    // compensates the records index ... index + n - 1 that are not
+    // cached yet, e.g. before an export of the whole history
+    void compensate(uint index = 0, uint n = N) {
+        if (index + n > count)
+            n = (index < count) ? count - index : 0;
+        for (uint i = index; i < index + n; i++) {
+            uint slot = (head + i) % N;
+            if (cached[slot / 32] & (1u << (slot % 32)))
+                continue;
+            uint64_t r = records[slot];
+            values[slot] = sensor.compensate((r >> 44) & 0xfffff, (r >> 24) & 0xfffff, (r >> 8) & 0xffff);
+            cached[slot / 32] |= 1u << (slot % 32);
+        }
+    }
+
+    // clock() of a record within 1 s, counted back from the newest
+    // record, whose time is exact. A gap of more than 255 s is kept as
+    // 255 s: the records before it appear later by the excess.
+    // 0 if index >= size()
+    uint64_t get_time_us(uint index) const {
+        if (index >= count)
+            return 0;
+        uint64_t t = last_us;
+        for (uint i = count - 1; i > index; i--)
+            t -= delta(records[(head + i) % N]) * 1000000ull;
+        return t;
+    }
+
+private:
+    static uint64_t pack(const uint8_t *data, uint64_t seconds) {
+        return ((uint64_t) BME280::adc_temperature(data) << 44)
+             | ((uint64_t) BME280::adc_pressure(data)    << 24)
+             | ((uint64_t) BME280::adc_humidity(data)    <<  8)
+             | seconds;
+    }
+    static uint64_t delta(uint64_t record) { return record & 0xff; }
+    static inline const BME280::MeasurementFixed_t none = {};
+
+    BME280  &sensor;
+    uint64_t records[N];                    // T:20 | P:20 | H:16 | seconds:8
+    BME280::MeasurementFixed_t values[N];   // compensation cache
+    uint32_t cached[(N + 31) / 32];         // valid entries of values
+    uint     head;                          // slot of the oldest record
+    uint     count;
+    uint64_t chain_us;                      // time of the newest record as the deltas give it
+    uint64_t last_us;                       // time of the newest record
+};
@@ -2,6 +2,7 @@
 #include "bme280_spi.hpp"
 
 
+#ifndef BME280_USE_I2C
 // Initialize BME280 sensor
 BME280::BME280(  uint spi_no    = 0, 
                  uint rx_pin    = PICO_DEFAULT_SPI_RX_PIN, 
@@ -9,15 +10,14 @@ BME280::BME280(  uint spi_no    = 0,
                  uint sck_pin   = PICO_DEFAULT_SPI_SCK_PIN, 
                  uint cs_pin    = PICO_DEFAULT_SPI_CSN_PIN, 
                  uint freq      = 500 * 1000,
-                 MODE mode      = MODE::MODE_NORMAL) {
+                 MODE mode      = MODE::MODE_NORMAL,
+                 TRANSPORT transport) {
 
     this->spi_no            = spi_no;
     this->rx_pin            = rx_pin;
     this->tx_pin            = tx_pin;
     this->sck_pin           = sck_pin;
-    this->cs_pin            = cs_pin;
     this->freq              = freq;
-    measurement_reg.mode    = mode;
        
     switch (spi_no) {
         case 0: spi_hw = spi0;
@@ -35,6 +35,27 @@ BME280::BME280(  uint spi_no    = 0,
     gpio_set_function(tx_pin, GPIO_FUNC_SPI);
     // Make the SPI pins available to picotool
     bi_decl(bi_3pins_with_func(rx_pin, tx_pin, sck_pin, GPIO_FUNC_SPI));
+
+    init_spi(cs_pin, transport);
+    init(mode);
+};
+
+// Initialize a BME280 sensor on an SPI bus set up by the caller
+BME280::BME280(spi_inst_t *spi, uint cs_pin, MODE mode, TRANSPORT transport) {
+    this->spi_hw            = spi;
+    this->spi_no            = spi_get_index(spi);
+    this->rx_pin            = 0; // pins belong to the owner of the bus
+    this->tx_pin            = 0;
+    this->sck_pin           = 0;
+    this->freq              = spi_get_baudrate(spi);
+    init_spi(cs_pin, transport);
+    init(mode);
+}
+
+void BME280::init_spi(uint cs_pin, TRANSPORT transport) {
+    this->cs_pin            = cs_pin;
+    this->transport         = TRANSPORT::TRANSPORT_BLOCKING;
+
     // Chip select is active-low, so we'll initialise it to a driven-high state
     gpio_init(cs_pin);
     gpio_set_dir(cs_pin, GPIO_OUT);
@@ -42,107 +63,479 @@ BME280::BME280(  uint spi_no    = 0,
     // Make the CS pin available to picotool
     bi_decl(bi_1pin_with_name(cs_pin, "SPI CS"));
 
-    // See if SPI is working - interrograte the device for its I2C ID number, should be 0x60
-    read_registers(0xD0, &chip_id, 1);
-  
-    // read compensation params once
+    // DMA channels are claimed per instance; CS is driven by the transport
+    if (transport == TRANSPORT::TRANSPORT_DMA && SPIDMAInit(&dma, spi_hw, cs_pin) == 0)
+        this->transport = TRANSPORT::TRANSPORT_DMA;
+}
+#else
+// Initialize a BME280 sensor on an I2C bus, usually the one of the OLED
+BME280::BME280(BBI2C *bus, uint32_t clock, uint8_t addr, MODE mode) {
+    this->bus               = bus;
+    this->i2c_addr          = addr;
+    this->transport         = TRANSPORT::TRANSPORT_BLOCKING;
+    // the bus may be used before its other devices initialise it
+    I2CInit(bus, clock);
+    init(mode);
+}
+#endif
+
+void BME280::init(MODE mode) {
+    this->last_error        = PICO_OK;
+    this->conversion_pending = false;
+    this->ready_alarm       = 0;
+    this->clock             = time_us_64;
+    this->prefetch_pending  = false;
+    this->sample_time_us    = 0;
+    this->staleness_us      = 0;
+    this->measurement.valid = 0;
+    this->measurement_fixed.valid = 0;
+    this->shadow_valid      = false;
+    this->data_fresh        = false;
+    this->transactions      = 0;
+    set_schedule(0, 0, 0);
+    measurement_reg.mode    = mode;
+
+    // the object may be constructed right after power-on
+    sleep_us(STARTUP_TIME_US);
+
+    // read chip id (should be 0x60) and compensation params once
     read_compensation_parameters();
     
-    measurement_reg.osrs_p = 0b011; // x4 Oversampling
-    measurement_reg.osrs_t = 0b011; // x4 Oversampling
-    write_register(0xF4, MODE::MODE_SLEEP); //SLEEP_MODE ensures configuration is saved
- 
-    // save configuration
-    write_register(0xF2, 0x1); // Humidity oversampling register - going for x1
-    write_register(0xF4, measurement_reg.get());// Set rest of oversampling modes and run mode to normal
-};
+    measurement_reg.osrs_p = (DefaultConfig::ctrl_meas >> 2) & 0x7; // x4 Oversampling
+    measurement_reg.osrs_t = (DefaultConfig::ctrl_meas >> 5) & 0x7; // x4 Oversampling
+    osrs_h                 = DefaultConfig::ctrl_hum;                // x1 Oversampling
+    config_reg             = DefaultConfig::config;                  // no filter
+    write_configuration(osrs_h, measurement_reg.get(), config_reg);
+}
+
+// The configuration is only accepted in sleep mode, and changes of
+// ctrl_hum only become effective after a write to ctrl_meas.
+// The BME280 takes several (register, value) pairs in one transaction.
+void BME280::write_configuration(uint8_t ctrl_hum, uint8_t ctrl_meas, uint8_t config) {
+    uint8_t pairs[8];
+    uint    len = 0;
+    // in forced mode the sensor sleeps until trigger()
+    if ((ctrl_meas & 0x3) == MODE::MODE_FORCED)
+        ctrl_meas &= ~0x3;
+    uint8_t meas = shadow_valid ? shadow_ctrl_meas : 0xff; // 0xff: unknown
+    if (!shadow_valid || config != shadow_config) {
+        if (!shadow_valid || (meas & 0x3) == MODE::MODE_NORMAL) {
+            pairs[len++] = REG_CTRL_MEAS;   // sleep mode ensures configuration is saved
+            pairs[len++] = meas = MODE::MODE_SLEEP;
+        }
+        pairs[len++] = REG_CONFIG;          // standby time and IIR filter
+        pairs[len++] = config;
+    }
+    bool hum_changed = !shadow_valid || ctrl_hum != shadow_ctrl_hum;
+    if (hum_changed) {
+        pairs[len++] = REG_CTRL_HUM;        // humidity oversampling
+        pairs[len++] = ctrl_hum;
+    }
+    if (hum_changed || ctrl_meas != meas) {
+        pairs[len++] = REG_CTRL_MEAS;       // oversampling of temperature and pressure, mode
+        pairs[len++] = ctrl_meas;
+    }
+    if (len > 0)
+        write_registers(pairs, len);
+    shadow_ctrl_hum  = ctrl_hum;
+    shadow_ctrl_meas = ctrl_meas;
+    shadow_config    = config;
+    shadow_valid     = true;
+}
+
+void BME280::trigger(uint8_t ctrl_hum, uint8_t ctrl_meas) {
+    uint8_t pairs[4];
+    uint    len = 0;
+    if (ctrl_hum != shadow_ctrl_hum) { // becomes effective with the ctrl_meas write
+        pairs[len++] = REG_CTRL_HUM;
+        pairs[len++] = ctrl_hum;
+        shadow_ctrl_hum = ctrl_hum;
+    }
+    pairs[len++] = REG_CTRL_MEAS;
+    pairs[len++] = ctrl_meas;
+    write_registers(pairs, len);
+    // back in sleep mode after the conversion
+    shadow_ctrl_meas = ctrl_meas & ~0x3;
+    data_fresh = false;
+}
+
+bool BME280::set_oversampling(OVERSAMPLING osrs_t, OVERSAMPLING osrs_p, OVERSAMPLING osrs_h) {
+    if (osrs_h == this->osrs_h && osrs_t == measurement_reg.osrs_t && osrs_p == measurement_reg.osrs_p)
+        return false;
+    this->osrs_h = osrs_h;
+    measurement_reg.osrs_t = osrs_t;
+    measurement_reg.osrs_p = osrs_p;
+    // in forced mode the next trigger() writes the new settings
+    if (measurement_reg.mode != MODE::MODE_FORCED)
+        write_configuration(this->osrs_h, measurement_reg.get(), config_reg);
+    return true;
+}
+
+bool BME280::set_filter(FILTER filter) {
+    uint8_t config = (config_reg & ~(0x7 << 2)) | (filter << 2);
+    if (config == config_reg)
+        return false;
+    config_reg = config;
+    write_configuration(osrs_h, measurement_reg.get(), config_reg);
+    return true;
+}
 
 BME280::Measurement_t BME280::measure() {
-    int32_t pressure, humidity, temperature;
-    if (measurement_reg.mode = MODE::MODE_FORCED) {
-        write_register(0xf4, measurement_reg.get());
-        uint8_t buffer;
-        do {
-            read_registers(0xf3, &buffer, 1);
-            sleep_ms(1);
-        } while (buffer & 0x08); // loop until measurement completed
+    measure_fixed();
+    if (last_error == PICO_OK)
+        measurement = to_float(measurement_fixed);
+    return measurement; // keeps the previous values on a timeout
+}
+
+BME280::MeasurementFixed_t BME280::measure_fixed() {
+    if (measurement_reg.mode == MODE::MODE_FORCED) {
+        start_measurement();
+        last_error = wait_for_conversion();
+        if (last_error != PICO_OK)
+            return measurement_fixed; // keep the previous values
     }
+    else
+        last_error = PICO_OK;
+    read_measurement();
+    conversion_pending = false;
+    sample_time_us = clock();
+    staleness_us   = 0;
+    return measurement_fixed;
+}
+
+BME280::RawSample_t BME280::measure_raw() {
+    RawSample_t sample;
+    if (measurement_reg.mode == MODE::MODE_FORCED) {
+        start_measurement();
+        last_error = wait_for_conversion();
+        if (last_error != PICO_OK) {
+            memset(&sample, 0, sizeof(sample));
+            return sample;
+        }
+    }
+    else
+        last_error = PICO_OK;
+    read_data(REG_PRESS_MSB, sample.data, sizeof(sample.data));
+    conversion_pending = false;
+    sample_time_us = clock();
+    staleness_us   = 0;
+    sample.time_us = sample_time_us;
+    return sample;
+}
+
+BME280::MeasurementFixed_t BME280::compensate(int32_t adc_T, int32_t adc_P, int32_t adc_H) {
+    MeasurementFixed_t values;
+    // a t_fine of its own: the member belongs to the last measurement
+    int32_t fine;
+    values.temperature = bme280_compensate_temperature(calib, adc_T, fine);
+    values.pressure    = bme280_compensate_pressure(calib, adc_P, fine);
+    values.humidity    = bme280_compensate_humidity(calib, adc_H, fine);
+    values.altitude    = altitude_cm(values.pressure, values.temperature);
+    values.valid       = VALID_ALL;
+    return values;
+}
+
+BME280::Measurement_t BME280::to_float(const MeasurementFixed_t &values) {
+    Measurement_t result;
+    result.temperature = values.temperature / 100.0f;
+    result.humidity    = values.humidity / 1024.0f;
+    result.pressure    = values.pressure / 100.0f; // hPa
+    result.altitude    = values.altitude / 100.0f; // m
+    result.valid       = values.valid;
+    return result;
+}
+
+absolute_time_t BME280::start_measurement(std::function<void(BME280&)> on_ready) {
+    if (ready_alarm) { // a previous measurement is still waiting for its alarm
+        cancel_alarm(ready_alarm);
+        ready_alarm = 0;
+    }
+    // in normal mode the sensor converts continuously
+    if (measurement_reg.mode == MODE::MODE_FORCED)
+        trigger(osrs_h, measurement_reg.get());
+    absolute_time_t now = get_absolute_time();
+    conversion_typ      = delayed_by_us(now, conversion_time_typ_us(measurement_reg.osrs_t, measurement_reg.osrs_p, osrs_h));
+    conversion_due      = delayed_by_us(now, get_conversion_time_us());
+    conversion_pending  = true;
+    ready_callback      = on_ready;
+    if (ready_callback) {
+        alarm_id_t id = add_alarm_at(conversion_due, &BME280::ready_alarm_handler, this, true);
+        ready_alarm = (id > 0) ? id : 0;
+    }
+    return conversion_due;
+}
+
+bool BME280::is_ready() {
+    if (!conversion_pending || measurement_reg.mode != MODE::MODE_FORCED)
+        return true;
+    if (time_reached(conversion_due))
+        return true;
+    if (!time_reached(conversion_typ))
+        return false;
+    return !read_status();
+}
+
+bool BME280::try_collect(Measurement_t &values) {
+    MeasurementFixed_t fixed;
+    if (!try_collect_fixed(fixed))
+        return false;
+    measurement = to_float(fixed);
+    values = measurement;
+    return true;
+}
+
+bool BME280::try_collect_fixed(MeasurementFixed_t &values) {
+    if (!is_ready())
+        return false;
+    read_measurement();
+    conversion_pending = false;
+    last_error = PICO_OK;
+    sample_time_us = clock();
+    staleness_us   = 0;
+    values = measurement_fixed;
+    return true;
+}
+
+void BME280::prefetch() {
+    start_measurement();
+    // the conversion completes during the sleep phase
+    sample_time_us   = clock() + get_conversion_time_us();
+    prefetch_pending = true;
+}
+
+bool BME280::collect_prefetched(Measurement_t &values) {
+    MeasurementFixed_t fixed;
+    if (!collect_prefetched_fixed(fixed))
+        return false;
+    measurement = to_float(fixed);
+    values = measurement;
+    return true;
+}
+
+bool BME280::collect_prefetched_fixed(MeasurementFixed_t &values) {
+    if (!prefetch_pending)
+        return false;
+    prefetch_pending = false;
+    // Usually the Pico slept much longer than the conversion takes.
+    // If the clock cannot prove it (short sleep, or DORMANT mode where
+    // the sleep time is unknown), ask the sensor before reading.
+    if (clock() < sample_time_us && read_status()) {
+        last_error = wait_for_conversion();
+        if (last_error != PICO_OK)
+            return false;
+    }
+    read_measurement(); // one 8 byte burst from 0xF7, or the data read with the status
+    conversion_pending = false;
+    last_error = PICO_OK;
+    uint64_t now = clock();
+    staleness_us = (now > sample_time_us) ? now - sample_time_us : 0;
+    values = measurement_fixed;
+    return true;
+}
+
+// fires once at conversion_due and hands the sensor to the user callback
+int64_t BME280::ready_alarm_handler(alarm_id_t, void *user_data) {
+    BME280 *sensor = static_cast<BME280 *>(user_data);
+    sensor->ready_alarm = 0;
+    if (sensor->ready_callback)
+        sensor->ready_callback(*sensor);
+    return 0; // do not reschedule
+}
+
+void BME280::read_measurement() {
+    int32_t pressure, humidity, temperature;
     // read raw sensor data from BME280
     bme280_read_raw(&humidity,
                     &pressure,
                     &temperature);
     // compensate raw sensor values
-    pressure = compensate_pressure(pressure);
-    humidity = compensate_humidity(humidity);
-    temperature = compensate_temp(temperature);
-    measurement.pressure = pressure / 100.0;
-    measurement.humidity = humidity / 1024.0;
-    measurement.temperature = temperature / 100.0;
-    // apply formula to retrieve altitude from air pressure
-    // pressure at sea level required as a base
-    float pressure0 = 1013.25;
-    float tmp = pow(measurement.pressure / pressure0, 1.0 / 5.255);
-    measurement.altitude = (measurement.temperature + 273.15) * (1 - tmp) / (tmp * 0.0065);
-    
+    // temperature comes first since it provides t_fine for the others
+    measurement_fixed.temperature = compensate_temp(temperature);
+    measurement_fixed.pressure = compensate_pressure(pressure);
+    measurement_fixed.humidity = compensate_humidity(humidity);
+    measurement_fixed.altitude = altitude_cm(measurement_fixed.pressure, measurement_fixed.temperature);
+    measurement_fixed.valid = VALID_ALL;
+}
+
+void BME280::set_schedule(uint32_t temperature_ms, uint32_t pressure_ms, uint32_t humidity_ms) {
+    period_ms[0] = temperature_ms;
+    period_ms[1] = pressure_ms;
+    period_ms[2] = humidity_ms;
+    next_due_us[0] = next_due_us[1] = next_due_us[2] = 0; // all due now
+}
+
+BME280::Measurement_t BME280::measure_scheduled() {
+    // channels that were not due keep their previous values, valid clear
+    measurement = to_float(measure_scheduled_fixed());
     return measurement;
 }
 
+BME280::MeasurementFixed_t BME280::measure_scheduled_fixed() {
+    uint64_t now = clock();
+    bool due[3];
+    for (uint i = 0; i < 3; i++)
+        due[i] = (now >= next_due_us[i]);
+    measurement_fixed.valid = 0;
+    if (!due[0] && !due[1] && !due[2])
+        return measurement_fixed; // nothing to do
+
+    // osrs of the channels that are not due is skipped;
+    // pressure and humidity need t_fine from the temperature
+    uint osrs_t = due[0] ? (uint) measurement_reg.osrs_t : (uint) ((due[1] || due[2]) ? OVERSAMPLING_X1 : OVERSAMPLING_SKIPPED);
+    uint osrs_p = due[1] ? (uint) measurement_reg.osrs_p : (uint) OVERSAMPLING_SKIPPED;
+    uint osrs_hum = due[2] ? (uint) osrs_h : (uint) OVERSAMPLING_SKIPPED;
+
+    trigger(osrs_hum, (osrs_t << 5) | (osrs_p << 2) | MODE::MODE_FORCED);
+    absolute_time_t start = get_absolute_time();
+    conversion_typ = delayed_by_us(start, conversion_time_typ_us(osrs_t, osrs_p, osrs_hum));
+    conversion_due = delayed_by_us(start, conversion_time_max_us(osrs_t, osrs_p, osrs_hum));
+    last_error = wait_for_conversion();
+    if (last_error != PICO_OK)
+        return measurement_fixed;
+
+    // read press 0xF7..0xF9, temp 0xFA..0xFC, hum 0xFD..0xFE as needed
+    uint8_t raw[8];
+    uint8_t first = due[1] ? REG_PRESS_MSB : REG_TEMP_MSB;
+    uint8_t last  = due[2] ? REG_HUM_LSB : REG_HUM_MSB - 1;
+    read_data(first, raw, last - first + 1);
+
+    int32_t adc;
+    adc = ((uint32_t) raw[3] << 12) | ((uint32_t) raw[4] << 4) | (raw[5] >> 4);
+    measurement_fixed.temperature = compensate_temp(adc);
+    measurement_fixed.valid |= VALID_TEMPERATURE;
+    if (due[1]) {
+        adc = ((uint32_t) raw[0] << 12) | ((uint32_t) raw[1] << 4) | (raw[2] >> 4);
+        measurement_fixed.pressure = compensate_pressure(adc);
+        measurement_fixed.altitude = altitude_cm(measurement_fixed.pressure, measurement_fixed.temperature);
+        measurement_fixed.valid |= VALID_PRESSURE | VALID_ALTITUDE;
+    }
+    if (due[2]) {
+        adc = (uint32_t) raw[6] << 8 | raw[7];
+        measurement_fixed.humidity = compensate_humidity(adc);
+        measurement_fixed.valid |= VALID_HUMIDITY;
+    }
+
+    // next due time; do not try to catch up missed periods
+    for (uint i = 0; i < 3; i++) {
+        if (due[i]) {
+            next_due_us[i] += period_ms[i] * 1000ull;
+            if (next_due_us[i] <= now)
+                next_due_us[i] = now + period_ms[i] * 1000ull;
+        }
+    }
+    conversion_pending = false;
+    sample_time_us = now;
+    staleness_us   = 0;
+    return measurement_fixed;
+}
+
+// (p / 101325 Pa)^(-1 / 5.255) - 1 in Q24 for p = 30000 + i * 512 Pa,
+// the tail end reaches 110384 Pa
+static const uint     ALT_P_MIN   = 30000;
+static const uint     ALT_P_SHIFT = 9;
+static const uint     ALT_ENTRIES = 158;
+static const int32_t  alt_table[ALT_ENTRIES] = {
+     4372714,  4304714,  4238059,  4172701,  4108594,  4045695,
+     3983962,  3923356,  3863840,  3805379,  3747938,  3691485,
+     3635990,  3581423,  3527755,  3474960,  3423013,  3371887,
+     3321561,  3272010,  3223214,  3175151,  3127802,  3081147,
+     3035168,  2989846,  2945166,  2901109,  2857661,  2814807,
+     2772530,  2730818,  2689657,  2649032,  2608933,  2569345,
+     2530258,  2491659,  2453538,  2415885,  2378687,  2341936,
+     2305621,  2269734,  2234265,  2199205,  2164545,  2130278,
+     2096395,  2062888,  2029749,  1996972,  1964549,  1932473,
+     1900738,  1869336,  1838261,  1807508,  1777069,  1746940,
+     1717114,  1687586,  1658351,  1629403,  1600736,  1572347,
+     1544230,  1516380,  1488793,  1461464,  1434388,  1407563,
+     1380982,  1354643,  1328541,  1302672,  1277032,  1251619,
+     1226427,  1201454,  1176696,  1152150,  1127812,  1103680,
+     1079749,  1056018,  1032482,  1009139,   985986,   963021,
+      940240,   917641,   895221,   872977,   850907,   829009,
+      807280,   785718,   764320,   743083,   722007,   701088,
+      680325,   659715,   639257,   618947,   598785,   578768,
+      558894,   539162,   519570,   500115,   480797,   461613,
+      442561,   423640,   404849,   386185,   367648,   349235,
+      330945,   312776,   294728,   276798,   258985,   241288,
+      223705,   206235,   188877,   171630,   154491,   137460,
+      120536,   103717,    87003,    70391,    53881,    37472,
+       21163,     4951,   -11162,   -27180,   -43102,   -58930,
+      -74665,   -90308,  -105859,  -121320,  -136692,  -151976,
+     -167172,  -182282,  -197307,  -212246,  -227102,  -241875,
+     -256566,  -271175,
+};
+// 10000 / 65 in Q16: cm per (0.01 K * Q24) is 1 / 0.0065 K/m
+static const int64_t  ALT_SCALE   = 10082462;
+
+// barometric formula h = T / 0.0065 * ((p / p0)^(-1 / 5.255) - 1)
+int32_t BME280::altitude_cm(uint32_t pressure, int32_t temperature) {
+    // pressures outside the table extrapolate from its end segments
+    int32_t offset = (int32_t) pressure - (int32_t) ALT_P_MIN;
+    int32_t i = offset >> ALT_P_SHIFT;
+    if (i < 0) i = 0;
+    if (i > (int32_t) ALT_ENTRIES - 2) i = ALT_ENTRIES - 2;
+    int32_t frac = offset - (i << ALT_P_SHIFT);
+    int32_t g = alt_table[i] + (((alt_table[i + 1] - alt_table[i]) * frac) >> ALT_P_SHIFT);
+    int64_t kelvin = temperature + 27315; // 0.01 K
+    return (int32_t) ((g * kelvin * ALT_SCALE) >> 40);
+}
+
 uint8_t BME280::get_chipID() {
     return chip_id;
 }
 
-// for the compensate_functions read the Bosch information on the BME280
-int32_t BME280::compensate_temp(int32_t adc_T) {
-    int32_t var1, var2, T;
-    var1 = ((((adc_T >> 3) - ((int32_t) dig_T1 << 1))) * ((int32_t) dig_T2)) >> 11;
-    var2 = (((((adc_T >> 4) - ((int32_t) dig_T1)) * ((adc_T >> 4) - ((int32_t) dig_T1))) >> 12) * ((int32_t) dig_T3))
-            >> 14;
+uint32_t BME280::get_conversion_time_us() const {
+    return conversion_time_max_us(measurement_reg.osrs_t, measurement_reg.osrs_p, osrs_h);
+}
 
-    t_fine = var1 + var2;
-    T = (t_fine * 5 + 128) >> 8;
-    return T;
+// A forced conversion takes a fixed time that only depends on the
+// oversampling settings. Sleep once until the maximum time (sleep_until()
+// waits with WFE until the timer alarm fires) instead of polling the
+// status register from the typical time on: each poll costs a bus
+// transaction, and the conversion usually ends close to the maximum.
+// Status and data are then read in one burst; if the sensor still
+// measures, check once more after the margin before giving up.
+int BME280::wait_for_conversion() {
+    sleep_until(conversion_due);
+    if (!read_status())
+        return PICO_OK;
+    sleep_until(delayed_by_us(conversion_due, TIMEOUT_MARGIN_US));
+    if (!read_status())
+        return PICO_OK;
+    return PICO_ERROR_TIMEOUT;
 }
 
-uint32_t BME280::compensate_pressure(int32_t adc_P) {
-    int32_t var1, var2;
-    uint32_t p;
-    var1 = (((int32_t) t_fine) >> 1) - (int32_t) 64000;
-    var2 = (((var1 >> 2) * (var1 >> 2)) >> 11) * ((int32_t) dig_P6);
-    var2 = var2 + ((var1 * ((int32_t) dig_P5)) << 1);
-    var2 = (var2 >> 2) + (((int32_t) dig_P4) << 16);
-    var1 = (((dig_P3 * (((var1 >> 2) * (var1 >> 2)) >> 13)) >> 3) + ((((int32_t) dig_P2) * var1) >> 1)) >> 18;
-    var1 = ((((32768 + var1)) * ((int32_t) dig_P1)) >> 15);
-    if (var1 == 0)
-        return 0;
-
-    p = (((uint32_t) (((int32_t) 1048576) - adc_P) - (var2 >> 12))) * 3125;
-    if (p < 0x80000000)
-        p = (p << 1) / ((uint32_t) var1);
+bool BME280::read_status() {
+    uint8_t regs[REG_HUM_LSB - REG_STATUS + 1];
+    read_registers(REG_STATUS, regs, sizeof(regs));
+    if (regs[0] & 0x08) // measuring
+        return true;
+    memcpy(data_regs, &regs[REG_PRESS_MSB - REG_STATUS], sizeof(data_regs));
+    data_fresh = true;
+    return false;
+}
+
+void BME280::read_data(uint8_t first, uint8_t *raw, uint8_t len) {
+    if (data_fresh)
+        memcpy(raw, data_regs, sizeof(data_regs));
     else
-        p = (p / (uint32_t) var1) * 2;
+        read_registers(first, &raw[first - REG_PRESS_MSB], len);
+    data_fresh = false;
+}
 
-    var1 = (((int32_t) dig_P9) * ((int32_t) (((p >> 3) * (p >> 3)) >> 13))) >> 12;
-    var2 = (((int32_t) (p >> 2)) * ((int32_t) dig_P8)) >> 13;
-    p = (uint32_t) ((int32_t) p + ((var1 + var2 + dig_P7) >> 4));
+// for the compensate_functions read the Bosch information on the BME280
+int32_t BME280::compensate_temp(int32_t adc_T) {
+    return bme280_compensate_temperature(calib, adc_T, t_fine);
+}
 
-    return p;
+uint32_t BME280::compensate_pressure(int32_t adc_P) {
+    return bme280_compensate_pressure(calib, adc_P, t_fine);
 }
 
 uint32_t BME280::compensate_humidity(int32_t adc_H) {
-    int32_t v_x1_u32r;
-    v_x1_u32r = (t_fine - ((int32_t) 76800));
-    v_x1_u32r = (((((adc_H << 14) - (((int32_t) dig_H4) << 20) - (((int32_t) dig_H5) * v_x1_u32r)) +
-                   ((int32_t) 16384)) >> 15) * (((((((v_x1_u32r * ((int32_t) dig_H6)) >> 10) * (((v_x1_u32r *
-                                                                                                  ((int32_t) dig_H3))
-            >> 11) + ((int32_t) 32768))) >> 10) + ((int32_t) 2097152)) *
-                                                 ((int32_t) dig_H2) + 8192) >> 14));
-    v_x1_u32r = (v_x1_u32r - (((((v_x1_u32r >> 15) * (v_x1_u32r >> 15)) >> 7) * ((int32_t) dig_H1)) >> 4));
-    v_x1_u32r = (v_x1_u32r < 0 ? 0 : v_x1_u32r);
-    v_x1_u32r = (v_x1_u32r > 419430400 ? 419430400 : v_x1_u32r);
-
-    return (uint32_t) (v_x1_u32r >> 12);
+    return bme280_compensate_humidity(calib, adc_H, t_fine);
 }
 
+#ifndef BME280_USE_I2C
 // select BME280 sensor on SPI bus
 inline void BME280::cs_select() {
     asm volatile("nop \n nop \n nop");
@@ -157,14 +550,17 @@ inline void BME280::cs_deselect() {
     asm volatile("nop \n nop \n nop");
 }
 
-void BME280::write_register(uint8_t reg, uint8_t data) {
-    uint8_t buf[2];
-    buf[0] = reg & 0x7f;  // remove read bit as this is a write
-    buf[1] = data;
+void BME280::write_registers(uint8_t *pairs, uint len) {
+    for (uint i = 0; i < len; i += 2)
+        pairs[i] &= 0x7f;  // remove read bit as this is a write
+    transactions++;
+    if (transport == TRANSPORT::TRANSPORT_DMA) {
+        SPIDMATransfer(&dma, pairs, NULL, len);
+        return;
+    }
     cs_select();
-    spi_write_blocking(spi_hw, buf, 2);
+    spi_write_blocking(spi_hw, pairs, len);
     cs_deselect();
-    sleep_ms(10);
 }
 
 void BME280::read_registers(uint8_t reg, uint8_t *buf, uint16_t len) {
@@ -172,50 +568,75 @@ void BME280::read_registers(uint8_t reg, uint8_t *buf, uint16_t len) {
     // first, then subsequently read from the device. The register is auto incrementing
     // so we don't need to keep sending the register we want, just the first.
     reg |= READ_BIT;
+    transactions++;
+    if (transport == TRANSPORT::TRANSPORT_DMA && len < sizeof(dma_buf)) {
+        // address and data phase in one transfer: the received
+        // bytes overwrite the transmitted ones in place, since
+        // RX always trails TX
+        dma_buf[0] = reg;
+        memset(&dma_buf[1], 0, len);
+        SPIDMATransfer(&dma, dma_buf, dma_buf, len + 1);
+        memcpy(buf, &dma_buf[1], len);
+        return;
+    }
     cs_select();
     spi_write_blocking(spi_hw, &reg, 1);
-    sleep_ms(10);
     spi_read_blocking(spi_hw, 0, buf, len);
     cs_deselect();
-    sleep_ms(10);
 }
+#else
+void BME280::write_registers(uint8_t *pairs, uint len) {
+    // the BME280 takes (register, value) pairs in one write as well
+    transactions++;
+    I2CWrite(bus, i2c_addr, pairs, len);
+}
+
+void BME280::read_registers(uint8_t reg, uint8_t *buf, uint16_t len) {
+    // register address, repeated start and data phase form one bus
+    // transaction, the register address auto-increments
+    transactions++;
+    I2CReadRegister(bus, i2c_addr, reg, buf, len);
+}
+#endif
 
 
 /* This function reads the manufacturing assigned compensation parameters from the device */
 void BME280::read_compensation_parameters() {
-   
-
-    read_registers(0x88, buffer, 26);
+    // one burst over both calibration blocks, the chip id lies between them
+    uint8_t buffer[REG_CALIB_26 + 7 - REG_CALIB_00];
+    read_registers(REG_CALIB_00, buffer, sizeof(buffer));
 
-    dig_T1 = buffer[0] | (buffer[1] << 8);
-    dig_T2 = buffer[2] | (buffer[3] << 8);
-    dig_T3 = buffer[4] | (buffer[5] << 8);
+    chip_id = buffer[REG_CHIP_ID - REG_CALIB_00];
 
-    dig_P1 = buffer[6] | (buffer[7] << 8);
-    dig_P2 = buffer[8] | (buffer[9] << 8);
-    dig_P3 = buffer[10] | (buffer[11] << 8);
-    dig_P4 = buffer[12] | (buffer[13] << 8);
-    dig_P5 = buffer[14] | (buffer[15] << 8);
-    dig_P6 = buffer[16] | (buffer[17] << 8);
-    dig_P7 = buffer[18] | (buffer[19] << 8);
-    dig_P8 = buffer[20] | (buffer[21] << 8);
-    dig_P9 = buffer[22] | (buffer[23] << 8);
+    calib.dig_T1 = buffer[0] | (buffer[1] << 8);
+    calib.dig_T2 = buffer[2] | (buffer[3] << 8);
+    calib.dig_T3 = buffer[4] | (buffer[5] << 8);
 
-    dig_H1 = buffer[25];
+    calib.dig_P1 = buffer[6] | (buffer[7] << 8);
+    calib.dig_P2 = buffer[8] | (buffer[9] << 8);
+    calib.dig_P3 = buffer[10] | (buffer[11] << 8);
+    calib.dig_P4 = buffer[12] | (buffer[13] << 8);
+    calib.dig_P5 = buffer[14] | (buffer[15] << 8);
+    calib.dig_P6 = buffer[16] | (buffer[17] << 8);
+    calib.dig_P7 = buffer[18] | (buffer[19] << 8);
+    calib.dig_P8 = buffer[20] | (buffer[21] << 8);
+    calib.dig_P9 = buffer[22] | (buffer[23] << 8);
 
-    read_registers(0xE1, buffer, 8);
+    calib.dig_H1 = buffer[25];
 
-    dig_H2 = buffer[0] | (buffer[1] << 8);
-    dig_H3 = (int8_t) buffer[2];
-    dig_H4 = buffer[3] << 4 | (buffer[4] & 0xf);
-    dig_H5 = (buffer[5] >> 4) | (buffer[6] << 4);
-    dig_H6 = (int8_t) buffer[7];
+    uint8_t *h = &buffer[REG_CALIB_26 - REG_CALIB_00]; // 0xE1 ... 0xE7
+    calib.dig_H2 = h[0] | (h[1] << 8);
+    calib.dig_H3 = h[2];
+    // H4 and H5 are signed 12 bit values sharing 0xE5
+    calib.dig_H4 = (int16_t) ((int8_t) h[3] * 16) | (h[4] & 0xf);
+    calib.dig_H5 = (int16_t) ((int8_t) h[5] * 16) | (h[4] >> 4);
+    calib.dig_H6 = (int8_t) h[6];
 }
 
 // this functions reads the raw data values from the sensor
 void BME280::bme280_read_raw(int32_t *humidity, int32_t *pressure, int32_t *temperature) {
     uint8_t readBuffer[8];
-    read_registers(0xF7, readBuffer, 8);
+    read_data(REG_PRESS_MSB, readBuffer, 8);
     *pressure = ((uint32_t) readBuffer[0] << 12) | ((uint32_t) readBuffer[1] << 4) | (readBuffer[2] >> 4);
     *temperature = ((uint32_t) readBuffer[3] << 12) | ((uint32_t) readBuffer[4] << 4) | (readBuffer[5] >> 4);
     *humidity = (uint32_t) readBuffer[6] << 8 | readBuffer[7];
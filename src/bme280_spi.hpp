@@ -2,10 +2,16 @@
 
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
+#include <functional>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
+#include "bme280_compensation.hpp"
+#ifdef BME280_USE_I2C
+#include "BitBang_I2C.h"
+#else
 #include "hardware/spi.h"
+#include "spi_dma.h"
+#endif
 
 
 
@@ -21,17 +27,58 @@ public:
     enum MODE { MODE_SLEEP = 0b00,
                 MODE_FORCED = 0b01,
                 MODE_NORMAL = 0b11};
+    // how register accesses are moved over the SPI bus
+    enum TRANSPORT { TRANSPORT_BLOCKING,   // CPU feeds the SPI FIFO
+                     TRANSPORT_DMA };      // DMA channels, CPU waits with WFE
+    // oversampling per channel (osrs_t, osrs_p, osrs_h)
+    enum OVERSAMPLING { OVERSAMPLING_SKIPPED = 0b000,
+                        OVERSAMPLING_X1      = 0b001,
+                        OVERSAMPLING_X2      = 0b010,
+                        OVERSAMPLING_X4      = 0b011,
+                        OVERSAMPLING_X8      = 0b100,
+                        OVERSAMPLING_X16     = 0b101};
+    // IIR filter coefficient (config register, filter)
+    enum FILTER { FILTER_OFF = 0b000,
+                  FILTER_2   = 0b001,
+                  FILTER_4   = 0b010,
+                  FILTER_8   = 0b011,
+                  FILTER_16  = 0b100};
+    // inactive time between conversions in normal mode (config register, t_sb)
+    enum STANDBY { STANDBY_0_5_MS  = 0b000,
+                   STANDBY_62_5_MS = 0b001,
+                   STANDBY_125_MS  = 0b010,
+                   STANDBY_250_MS  = 0b011,
+                   STANDBY_500_MS  = 0b100,
+                   STANDBY_1000_MS = 0b101,
+                   STANDBY_10_MS   = 0b110,
+                   STANDBY_20_MS   = 0b111};
+    // register map (datasheet, section 5.3)
+    enum REGISTER { REG_CALIB_00  = 0x88,   // calibration T1 ... H1, up to 0xA1
+                    REG_CHIP_ID   = 0xD0,
+                    REG_RESET     = 0xE0,
+                    REG_CALIB_26  = 0xE1,   // calibration H2 ... H6, up to 0xE7
+                    REG_CTRL_HUM  = 0xF2,
+                    REG_STATUS    = 0xF3,
+                    REG_CTRL_MEAS = 0xF4,
+                    REG_CONFIG    = 0xF5,
+                    REG_PRESS_MSB = 0xF7,   // pressure 0xF7 ... 0xF9
+                    REG_TEMP_MSB  = 0xFA,   // temperature 0xFA ... 0xFC
+                    REG_HUM_MSB   = 0xFD,   // humidity 0xFD ... 0xFE
+                    REG_HUM_LSB   = 0xFE };
 private:
     const uint READ_BIT = 0x80;
+    // datasheet: the sensor needs 2 ms after power-on before it talks
+    static const uint32_t STARTUP_TIME_US   = 2000;
+    // extra time granted on top of the maximum conversion time
+    // before measure() gives up with PICO_ERROR_TIMEOUT
+    static const uint32_t TIMEOUT_MARGIN_US = 5000;
     int32_t     t_fine;
-    uint16_t    dig_T1;
-    int16_t     dig_T2, dig_T3;
-    uint16_t    dig_P1;
-    int16_t     dig_P2, dig_P3, dig_P4, dig_P5, dig_P6, dig_P7, dig_P8, dig_P9;
-    uint8_t     dig_H1, dig_H3;
-    int8_t      dig_H6;
-    int16_t     dig_H2, dig_H4, dig_H5;
+    BME280Calibration calib;
     int32_t     adc_T, adc_P, adc_H;
+#ifdef BME280_USE_I2C
+    BBI2C   *bus;       // I2C bus, shared with other devices
+    uint8_t i2c_addr;   // 0x76 (SDO to GND) or 0x77
+#else
     spi_inst_t  *spi_hw;
     uint spi_no;  // SPI unit spi0 or spi1
     uint rx_pin;  // SPI receive pin
@@ -39,10 +86,42 @@ private:
     uint sck_pin; // SPI clock
     uint cs_pin;  // SPI chip select pin
     uint freq;
-    uint8_t buffer[26]; // storage for compensation parameters
+    SPIDMA    dma;          // used with TRANSPORT_DMA
+    uint8_t   dma_buf[1 + REG_CALIB_26 + 7 - REG_CALIB_00]; // register address + longest burst (calibration, 96 bytes)
+#endif
+    TRANSPORT transport;
     uint8_t chip_id;
+    uint8_t osrs_h;     // humidity oversampling (register 0xF2)
+    uint8_t config_reg; // standby time and IIR filter (register 0xF5)
+    // shadow copies of the control registers: unchanged values are not written
+    bool    shadow_valid;       // false until the first write_configuration()
+    uint8_t shadow_ctrl_hum;
+    uint8_t shadow_ctrl_meas;   // forced mode is kept as sleep, the sensor returns to it
+    uint8_t shadow_config;
+    // data registers captured together with the status (read_status())
+    uint8_t data_regs[8];
+    bool    data_fresh;
+    uint32_t transactions;      // bus transactions since construction
+    int last_error;     // result of the last measure(): PICO_OK or PICO_ERROR_TIMEOUT
     MODE mode;
 
+    // per-channel schedule (measure_scheduled())
+    uint32_t period_ms[3];  // temperature, pressure, humidity
+    uint64_t next_due_us[3];
+
+    // state of an asynchronous measurement (start_measurement())
+    bool            conversion_pending;
+    absolute_time_t conversion_typ;     // earliest time the data may be ready
+    absolute_time_t conversion_due;     // time the data is guaranteed to be ready
+    alarm_id_t      ready_alarm;        // alarm firing the ready callback (0 = none)
+    std::function<void(BME280&)> ready_callback;
+
+    // pipelined acquisition (prefetch() / collect_prefetched())
+    uint64_t  (*clock)(void);    // time source in microseconds
+    bool      prefetch_pending;
+    uint64_t  sample_time_us;    // clock() when the last values were converted
+    uint64_t  staleness_us;      // age of the last values when they were read
+
 struct MeasurementControl_t {
     // temperature oversampling
     // 000 = skipped
@@ -80,10 +159,29 @@ public:
         float humidity;
         float pressure;
         float altitude;
+        uint8_t valid;      // VALID_* flags of the fields converted by this measurement
     } measurement;
+    enum VALID { VALID_TEMPERATURE = 0x1,
+                 VALID_PRESSURE    = 0x2,
+                 VALID_HUMIDITY    = 0x4,
+                 VALID_ALTITUDE    = 0x8,
+                 VALID_ALL         = 0xf};
 
+    // the same values in integer units as the compensation delivers
+    // them; the Cortex-M0+ has no FPU, so this is what all measurement
+    // paths compute, Measurement_t is derived from it by to_float().
+    // Each float path has a *_fixed() variant that never touches floats.
+    struct MeasurementFixed_t {
+        int32_t  temperature;   // 0.01 degrees celsius
+        uint32_t humidity;      // 1/1024 %RH
+        uint32_t pressure;      // Pa
+        int32_t  altitude;      // cm
+        uint8_t  valid;         // VALID_* flags
+    } measurement_fixed;
 
 
+
+#ifndef BME280_USE_I2C
     /*
     Constructor has the following default values for params
     uint spi_no    = 0, 
@@ -92,7 +190,10 @@ public:
     uint sck_pin   = PICO_DEFAULT_SPI_SCK_PIN, 
     uint cs_pin    = PICO_DEFAULT_SPI_CSN_PIN, 
     uint freq      = 500 * 1000,
-    MODE mode      = MODE_NORMAL) {
+    MODE mode      = MODE_NORMAL,
+    TRANSPORT transport = TRANSPORT_BLOCKING) {
+    If TRANSPORT_DMA is requested but no DMA channels are 
+    available, the sensor falls back to TRANSPORT_BLOCKING.
     */
     BME280( uint spi_no, 
             uint rx_pin, 
@@ -100,13 +201,257 @@ public:
             uint sck_pin, 
             uint cs_pin,
             uint freq,   
-            MODE mode);
+            MODE mode,
+            TRANSPORT transport = TRANSPORT_BLOCKING);
+
+    // Sensor on an SPI bus that is already initialised, e.g. by a
+    // BME280Group: only the chip select pin is set up here. Several
+    // sensors may share the bus with separate chip select pins; those
+    // of sensors not constructed yet must already be driven high.
+    BME280( spi_inst_t *spi,
+            uint cs_pin,
+            MODE mode = MODE_FORCED,
+            TRANSPORT transport = TRANSPORT_BLOCKING);
+#else
+    // Sensor on an I2C bus (compile with BME280_USE_I2C), typically
+    // the bus of the OLED: BME280(myOled.get_bus(), I2C_SPEED).
+    // Every register access is one bus transaction; the bus lock of
+    // BBI2C keeps it from interleaving with other devices.
+    BME280( BBI2C *bus,
+            uint32_t clock,
+            uint8_t addr = 0x76,
+            MODE mode = MODE_FORCED);
+#endif
 
 
     // get sensor values from BME280
     Measurement_t measure();
+
+    // Asynchronous measurement, split into start / poll / collect:
+    //   absolute_time_t due = sensor.start_measurement();
+    //   ... other work, or Sleep::instance().nap_until(due) ...
+    //   if (sensor.try_collect(values)) { ... }
+    // start_measurement() triggers a forced conversion and returns the
+    // time at which the data is guaranteed to be available. The optional
+    // callback is called from a timer alarm (interrupt context) at that
+    // time; keep it short and collect the values in the main loop.
+    absolute_time_t start_measurement(std::function<void(BME280&)> on_ready = nullptr);
+    // true once the pending conversion has completed (non-blocking;
+    // reads the status register only between the typical and the
+    // maximum conversion time)
+    bool is_ready();
+    // if the conversion has completed, read and compensate the values,
+    // store them in values and return true; otherwise return false
+    bool try_collect(Measurement_t &values);
+    bool try_collect_fixed(MeasurementFixed_t &values);
+
+    // Pipelined acquisition: prefetch() starts the next forced
+    // conversion right before the Pico goes to sleep, e.g. from
+    // Sleep::set_sleep_hook(). After waking up, collect_prefetched()
+    // reads the result that was converted during the sleep phase with
+    // a single burst, so no wake has to wait for a conversion. It
+    // returns false if no prefetch is pending. Use it only when the
+    // sleep phase has a known, bounded length (SLEEP mode): after a
+    // DORMANT phase the sample is as old as the phase, and a clock
+    // that stops in DORMANT mode reports a staleness of about 0.
+    void prefetch();
+    bool collect_prefetched(Measurement_t &values);
+    bool collect_prefetched_fixed(MeasurementFixed_t &values);
+    // time source used for sample timestamps; defaults to time_us_64()
+    // which stops while the Pico sleeps. Pass e.g. a function returning
+    // Sleep::instance().now_us() to account for SLEEP phases.
+    void set_clock(uint64_t (*clock)(void)) { this->clock = clock; }
+    // clock() at the time the last returned values were converted
+    uint64_t get_sample_time_us() const { return sample_time_us; }
+    // time between conversion and read of the last returned values
+    // (0 for measure() and try_collect())
+    uint64_t get_staleness_us() const { return staleness_us; }
     // get chip ID from sensor (=I2C address)
     uint8_t get_chipID();
+    // result of the last measure(): PICO_OK, or PICO_ERROR_TIMEOUT if
+    // the sensor did not finish its conversion in time. In the latter
+    // case measure() returned the previous values unchanged.
+    int get_last_error() const { return last_error; }
+
+    // conversion time for the current oversampling settings
+    // in microseconds (datasheet, appendix B "Measurement time")
+    uint32_t get_conversion_time_us() const;
+
+    // transport actually in use
+    TRANSPORT get_transport() const { return transport; }
+
+    // number of bus transactions (one CS-low phase, or one I2C
+    // transaction) since construction. A forced measure() takes
+    // two: the trigger, and status plus data in one burst at the
+    // maximum conversion time.
+    uint32_t get_transactions() const { return transactions; }
+
+    // oversampling register value (0 = skipped, 1 = x1, ... 5 = x16)
+    // to number of samples
+    static constexpr uint32_t oversampling_factor(uint osrs) {
+        return (osrs == 0) ? 0 : ((osrs >= 5) ? 16 : (1u << (osrs - 1)));
+    }
+    // typical measurement time in microseconds:
+    // 1 + 2 * T + (2 * P + 0.5) + (2 * H + 0.5) ms
+    static constexpr uint32_t conversion_time_typ_us(uint osrs_t, uint osrs_p, uint osrs_h) {
+        return 1000 + 2000 * oversampling_factor(osrs_t)
+                    + (osrs_p ? 2000 * oversampling_factor(osrs_p) + 500 : 0)
+                    + (osrs_h ? 2000 * oversampling_factor(osrs_h) + 500 : 0);
+    }
+    // maximum measurement time in microseconds:
+    // 1.25 + 2.3 * T + (2.3 * P + 0.575) + (2.3 * H + 0.575) ms
+    static constexpr uint32_t conversion_time_max_us(uint osrs_t, uint osrs_p, uint osrs_h) {
+        return 1250 + 2300 * oversampling_factor(osrs_t)
+                    + (osrs_p ? 2300 * oversampling_factor(osrs_p) + 575 : 0)
+                    + (osrs_h ? 2300 * oversampling_factor(osrs_h) + 575 : 0);
+    }
+
+    // Compile-time sensor configuration. All register values, the
+    // conversion time and the data burst are constexpr:
+    //   using Weather = BME280::Config<BME280::OVERSAMPLING_X1,      // temperature
+    //                                  BME280::OVERSAMPLING_X1,      // pressure
+    //                                  BME280::OVERSAMPLING_SKIPPED, // humidity
+    //                                  BME280::FILTER_OFF,
+    //                                  BME280::STANDBY_1000_MS,
+    //                                  BME280::MODE_FORCED>;
+    //   sensor.configure<Weather>();
+    //   BME280::Measurement_t values = sensor.measure<Weather>();
+    // Skipped channels shorten the burst read from 0xF7, and if constexpr
+    // removes their decoding and compensation calls from measure<CFG>(),
+    // so no channel is tested at run time (the compensate_* functions
+    // themselves stay in the binary, measure() uses them). Temperature cannot be
+    // skipped together with pressure or humidity, since their
+    // compensation depends on t_fine.
+    template <OVERSAMPLING T, OVERSAMPLING P, OVERSAMPLING H,
+              FILTER F = FILTER_OFF, STANDBY SB = STANDBY_0_5_MS, MODE M = MODE_FORCED>
+    struct Config {
+        static_assert(T != OVERSAMPLING_SKIPPED || (P == OVERSAMPLING_SKIPPED && H == OVERSAMPLING_SKIPPED),
+                      "pressure and humidity compensation need the temperature channel");
+        static constexpr MODE     mode             = M;
+        static constexpr bool     has_temperature  = (T != OVERSAMPLING_SKIPPED);
+        static constexpr bool     has_pressure     = (P != OVERSAMPLING_SKIPPED);
+        static constexpr bool     has_humidity     = (H != OVERSAMPLING_SKIPPED);
+        // register values
+        static constexpr uint8_t  ctrl_hum         = H;                          // 0xF2
+        static constexpr uint8_t  ctrl_meas        = (T << 5) | (P << 2) | M;    // 0xF4
+        static constexpr uint8_t  config           = (SB << 5) | (F << 2);       // 0xF5
+        // conversion time of a forced measurement in microseconds
+        static constexpr uint32_t conversion_time_typ_us = BME280::conversion_time_typ_us(T, P, H);
+        static constexpr uint32_t conversion_time_us     = BME280::conversion_time_max_us(T, P, H);
+        // data registers: press 0xF7..0xF9, temp 0xFA..0xFC, hum 0xFD..0xFE
+        static constexpr uint8_t  burst_start      = has_pressure ? REG_PRESS_MSB : REG_TEMP_MSB;
+        static constexpr uint8_t  burst_end        = has_humidity ? REG_HUM_LSB : REG_HUM_MSB - 1;
+        static constexpr uint8_t  burst_length     = burst_end - burst_start + 1;
+    };
+
+    // write the registers of a compile-time configuration
+    template <class CFG>
+    void configure() {
+        measurement_reg.osrs_t = (CFG::ctrl_meas >> 5) & 0x7;
+        measurement_reg.osrs_p = (CFG::ctrl_meas >> 2) & 0x7;
+        measurement_reg.mode   = CFG::mode;
+        osrs_h                 = CFG::ctrl_hum;
+        config_reg             = CFG::config;
+        write_configuration(CFG::ctrl_hum, CFG::ctrl_meas, CFG::config);
+    }
+
+    // measurement with a compile-time configuration, see Config;
+    // configure<CFG>() must have been called before.
+    // Fields of skipped channels keep their previous values.
+    template <class CFG>
+    Measurement_t measure() {
+        uint8_t raw[8];
+        int32_t temperature, pressure, humidity;
+
+        if constexpr (CFG::mode == MODE_FORCED) {
+            trigger(CFG::ctrl_hum, CFG::ctrl_meas);
+            absolute_time_t now = get_absolute_time();
+            conversion_typ = delayed_by_us(now, CFG::conversion_time_typ_us);
+            conversion_due = delayed_by_us(now, CFG::conversion_time_us);
+            last_error = wait_for_conversion();
+            if (last_error != PICO_OK)
+                return measurement; // keep the previous values
+        }
+        else
+            last_error = PICO_OK;
+        read_data(CFG::burst_start, raw, CFG::burst_length);
+        if constexpr (CFG::has_temperature) {
+            temperature = ((uint32_t) raw[3] << 12) | ((uint32_t) raw[4] << 4) | (raw[5] >> 4);
+            measurement_fixed.temperature = compensate_temp(temperature);
+        }
+        if constexpr (CFG::has_pressure) {
+            pressure = ((uint32_t) raw[0] << 12) | ((uint32_t) raw[1] << 4) | (raw[2] >> 4);
+            measurement_fixed.pressure = compensate_pressure(pressure);
+            measurement_fixed.altitude = altitude_cm(measurement_fixed.pressure, measurement_fixed.temperature);
+        }
+        if constexpr (CFG::has_humidity) {
+            humidity = (uint32_t) raw[6] << 8 | raw[7];
+            measurement_fixed.humidity = compensate_humidity(humidity);
+        }
+        measurement_fixed.valid = (CFG::has_temperature ? VALID_TEMPERATURE : 0)
+                                | (CFG::has_pressure ? VALID_PRESSURE | VALID_ALTITUDE : 0)
+                                | (CFG::has_humidity ? VALID_HUMIDITY : 0);
+        conversion_pending = false;
+        sample_time_us = clock();
+        staleness_us   = 0;
+        measurement = to_float(measurement_fixed);
+        return measurement;
+    }
+
+    // Per-channel sampling rates: measure_scheduled() converts,
+    // reads and compensates only the channels that are due, using
+    // the oversampling set for them; the others are skipped and
+    // keep their previous values with the valid flag cleared.
+    // Periods are in milliseconds, 0 means every call. Pressure and
+    // humidity compensation need t_fine, so the temperature is
+    // always converted along with them (with x1 if it is not due).
+    // Each call triggers a forced conversion.
+    void set_schedule(uint32_t temperature_ms, uint32_t pressure_ms, uint32_t humidity_ms);
+    Measurement_t measure_scheduled();
+    MeasurementFixed_t measure_scheduled_fixed();
+
+    // Float-free variant of measure(): fills and returns measurement_fixed,
+    // measurement is left untouched. Use to_float() where the values
+    // are presented. The same holds for try_collect_fixed(),
+    // collect_prefetched_fixed() and measure_scheduled_fixed().
+    MeasurementFixed_t measure_fixed();
+    static Measurement_t to_float(const MeasurementFixed_t &values);
+
+    // Raw samples: measure_raw() converts and reads the data registers
+    // 0xF7 ... 0xFE, but does not compensate them. compensate() turns
+    // such a sample into values later, e.g. when a BME280History is read.
+    struct RawSample_t {
+        uint8_t  data[8];   // press msb/lsb/xlsb, temp msb/lsb/xlsb, hum msb/lsb
+        uint64_t time_us;   // clock() at the conversion
+    };
+    RawSample_t measure_raw();
+    // adc values from the data registers
+    static int32_t adc_pressure(const uint8_t *data)    { return ((uint32_t) data[0] << 12) | ((uint32_t) data[1] << 4) | (data[2] >> 4); }
+    static int32_t adc_temperature(const uint8_t *data) { return ((uint32_t) data[3] << 12) | ((uint32_t) data[4] << 4) | (data[5] >> 4); }
+    static int32_t adc_humidity(const uint8_t *data)    { return ((uint32_t) data[6] << 8) | data[7]; }
+    // compensation with this sensor's calibration; changes neither measurement_fixed nor t_fine
+    MeasurementFixed_t compensate(int32_t adc_T, int32_t adc_P, int32_t adc_H);
+
+    // Altitude in cm from pressure in Pa and temperature in 0.01 degrees
+    // celsius (barometric formula, 1013.25 hPa at sea level). Integer
+    // only: the pressure term comes from a table with 512 Pa steps and
+    // linear interpolation. Compared to the float formula the error is
+    // below 57 cm from 300 to 1100 hPa and below 6 cm above 900 hPa,
+    // for -40 to 85 degrees celsius.
+    static int32_t altitude_cm(uint32_t pressure, int32_t temperature);
+
+    // the configuration set by the constructor
+    typedef Config<OVERSAMPLING_X4, OVERSAMPLING_X4, OVERSAMPLING_X1> DefaultConfig;
+
+    // runtime configuration; registers are only written when a value
+    // actually changes. In forced mode the new ctrl_meas value is
+    // written by the next trigger. Both return true on a change.
+    bool set_oversampling(OVERSAMPLING osrs_t, OVERSAMPLING osrs_p, OVERSAMPLING osrs_h);
+    bool set_filter(FILTER filter);
+    OVERSAMPLING get_oversampling_t() const { return (OVERSAMPLING) measurement_reg.osrs_t; }
+    OVERSAMPLING get_oversampling_p() const { return (OVERSAMPLING) measurement_reg.osrs_p; }
+    OVERSAMPLING get_oversampling_h() const { return (OVERSAMPLING) osrs_h; }
+    FILTER       get_filter() const { return (FILTER) ((config_reg >> 2) & 0x7); }
  
 
 
@@ -116,11 +461,34 @@ private:
     uint32_t    compensate_pressure(int32_t adc_P); 
     uint32_t    compensate_humidity(int32_t adc_H);
     void        bme280_read_raw(int32_t *humidity, int32_t *pressure, int32_t *temperature);
+    // waits for a forced conversion, returns PICO_OK or PICO_ERROR_TIMEOUT
+    int         wait_for_conversion();
+#ifndef BME280_USE_I2C
+    // sets up chip select and transport
+    void        init_spi(uint cs_pin, TRANSPORT transport);
     void        cs_select();
     void        cs_deselect();
-    void        write_register(uint8_t reg, uint8_t data);
+#endif
+    // reads the calibration and writes the default configuration
+    void        init(MODE mode);
+    // reads the data registers and updates measurement_fixed
+    void        read_measurement();
+    // starts a forced conversion, ctrl_hum is written along if it changed
+    void        trigger(uint8_t ctrl_hum, uint8_t ctrl_meas);
+    // writes the changed ones of ctrl_hum, ctrl_meas and config in the
+    // order the sensor needs, in one transaction
+    void        write_configuration(uint8_t ctrl_hum, uint8_t ctrl_meas, uint8_t config);
+    // reads status and data registers in one burst, keeps the data if
+    // the conversion has completed; returns true while measuring
+    bool        read_status();
+    // data registers first ... first + len - 1 into raw (indexed from
+    // REG_PRESS_MSB), taken from read_status() if it got them
+    void        read_data(uint8_t first, uint8_t *raw, uint8_t len);
+    static int64_t ready_alarm_handler(alarm_id_t id, void *user_data);
+    // (register, value) pairs in one transaction
+    void        write_registers(uint8_t *pairs, uint len);
     void        read_registers(uint8_t reg, uint8_t *buf, uint16_t len);
-    /* This function reads the manufacturing assigned compensation parameters from the device */
+    /* This function reads the chip id and the manufacturing assigned compensation parameters from the device */
     void        read_compensation_parameters(); 
 };
 
@@ -0,0 +1,255 @@
+// ss_large_prop.bdf converted by host/bdf2font: proportional font for
+// oledDrawPropString(), height 32, characters 32 ... 126, 3948 bytes
+// (87 characters run-length coded; 6840 bytes as fixed 18x32 cells)
+#pragma once
+#include <stdint.h>
+
+static const uint8_t ucLargePropFont[] = {
+0x20,0x20,0x7e,0x14,0x88,0x00,0x00,0x8a,0x02,0x00,0x8e,0x1b,0x00,0x90,0x2c,0x00,
+0x10,0x5d,0x00,0x90,0x9d,0x00,0x90,0xca,0x00,0x88,0x03,0x01,0x8a,0x10,0x01,0x8a,
+0x29,0x01,0x92,0x41,0x01,0x8e,0x72,0x01,0x88,0x8b,0x01,0x90,0x98,0x01,0x86,0xb5,
+0x01,0x90,0xbe,0x01,0x90,0xdb,0x01,0x8e,0x10,0x02,0x10,0x31,0x02,0x10,0x71,0x02,
+0x90,0xb1,0x02,0x10,0xde,0x02,0x90,0x1e,0x03,0x90,0x53,0x03,0x90,0x7b,0x03,0x90,
+0xb8,0x03,0x86,0xf1,0x03,0x88,0x02,0x04,0x8e,0x17,0x04,0x90,0x40,0x04,0x8e,0x79,
+0x04,0x90,0xa2,0x04,0x90,0xcf,0x04,0x90,0x04,0x05,0x90,0x2d,0x05,0x90,0x61,0x05,
+0x90,0x92,0x05,0x90,0xba,0x05,0x90,0xf2,0x05,0x90,0x1e,0x06,0x90,0x57,0x06,0x8a,
+0x73,0x06,0x90,0x8b,0x06,0x90,0xac,0x06,0x90,0xd4,0x06,0x90,0xf8,0x06,0x90,0x14,
+0x07,0x90,0x30,0x07,0x90,0x59,0x07,0x90,0x85,0x07,0x90,0xb2,0x07,0x10,0xde,0x07,
+0x8e,0x1e,0x08,0x90,0x3e,0x08,0x90,0x5a,0x08,0x90,0x76,0x08,0x90,0x92,0x08,0x8e,
+0xbe,0x08,0x10,0xde,0x08,0x8a,0x1e,0x09,0x90,0x36,0x09,0x8a,0x53,0x09,0x90,0x6b,
+0x09,0x92,0x84,0x09,0x86,0xad,0x09,0x90,0xb5,0x09,0x90,0xe6,0x09,0x90,0x0e,0x0a,
+0x90,0x3f,0x0a,0x90,0x68,0x0a,0x8e,0xa5,0x0a,0x90,0xca,0x0a,0x90,0xff,0x0a,0x8a,
+0x1f,0x0b,0x8e,0x3c,0x0b,0x90,0x61,0x0b,0x8a,0x89,0x0b,0x90,0x9d,0x0b,0x90,0xba,
+0x0b,0x90,0xd7,0x0b,0x90,0x00,0x0c,0x90,0x2d,0x0c,0x90,0x5a,0x0c,0x10,0x7f,0x0c,
+0x90,0xbf,0x0c,0x90,0xe4,0x0c,0x8e,0x01,0x0d,0x90,0x1a,0x0d,0x90,0x37,0x0d,0x90,
+0x64,0x0d,0x10,0x95,0x0d,0x8e,0xd5,0x0d,0x86,0xfa,0x0d,0x8e,0x0a,0x0e,0x90,0x2e,
+0x0e,0x7f,0x7f,0x01,0x85,0x19,0x85,0x17,0x8d,0x01,0x83,0x0b,0x8d,0x01,0x83,0x0b,
+0x8d,0x01,0x83,0x0b,0x8d,0x01,0x83,0x0d,0x85,0x19,0x85,0x57,0x83,0x1b,0x83,0x1b,
+0x85,0x19,0x85,0x7f,0x19,0x85,0x19,0x85,0x19,0x83,0x1b,0x83,0x5b,0x05,0x81,0x05,
+0x81,0x15,0x81,0x05,0x81,0x11,0x91,0x0d,0x91,0x0d,0x91,0x0d,0x91,0x11,0x81,0x05,
+0x81,0x0b,0x83,0x05,0x81,0x05,0x81,0x0b,0x83,0x01,0x91,0x07,0x83,0x01,0x91,0x07,
+0x83,0x01,0x91,0x0d,0x91,0x11,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x4f,0xfc,0xf0,
+0x00,0x00,0xfc,0xf0,0x00,0x00,0xff,0xc3,0x03,0x00,0xff,0xc3,0x03,0x00,0x03,0x03,
+0x03,0x00,0x03,0x03,0x03,0x00,0x03,0x03,0x3f,0x00,0x03,0x03,0x3f,0x00,0x03,0x03,
+0x3f,0x00,0x03,0x03,0x3f,0x00,0x0f,0xff,0x03,0x00,0x0f,0xff,0x03,0x00,0x3c,0xfc,
+0x00,0x00,0x3c,0xfc,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x83,
+0x07,0x83,0x0f,0x83,0x07,0x83,0x0f,0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x19,0x83,
+0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,0x83,0x05,0x83,0x11,0x83,
+0x05,0x83,0x0f,0x83,0x07,0x83,0x0f,0x83,0x07,0x83,0x4b,0x09,0x87,0x17,0x87,0x0f,
+0x83,0x01,0x8b,0x0d,0x83,0x01,0x8b,0x0b,0x89,0x07,0x81,0x09,0x8b,0x07,0x81,0x09,
+0x83,0x03,0x85,0x05,0x81,0x09,0x83,0x03,0x85,0x05,0x81,0x09,0x89,0x01,0x87,0x0d,
+0x87,0x01,0x87,0x0f,0x83,0x01,0x8b,0x0d,0x83,0x01,0x8b,0x13,0x81,0x07,0x81,0x13,
+0x81,0x07,0x81,0x4b,0x03,0x81,0x1d,0x81,0x19,0x85,0x19,0x85,0x19,0x83,0x1b,0x83,
+0x5b,0x03,0x8b,0x13,0x8b,0x11,0x8f,0x0f,0x8f,0x0d,0x83,0x0b,0x83,0x0b,0x83,0x0b,
+0x83,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,
+0x81,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0d,0x8f,0x0f,0x8f,0x11,0x8b,0x13,
+0x8b,0x4f,0x09,0x81,0x1d,0x81,0x19,0x81,0x01,0x81,0x01,0x81,0x15,0x81,0x01,0x81,
+0x01,0x81,0x15,0x89,0x15,0x89,0x17,0x85,0x19,0x85,0x19,0x85,0x19,0x85,0x17,0x89,
+0x15,0x89,0x15,0x81,0x01,0x81,0x01,0x81,0x15,0x81,0x01,0x81,0x01,0x81,0x19,0x81,
+0x1d,0x81,0x53,0x09,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x19,0x89,0x15,0x89,0x15,
+0x89,0x15,0x89,0x19,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x53,0x13,0x81,0x1d,0x81,
+0x17,0x87,0x17,0x87,0x17,0x85,0x19,0x85,0x4b,0x09,0x81,0x1d,0x81,0x1d,0x81,0x1d,
+0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,
+0x81,0x1d,0x81,0x1d,0x81,0x53,0x0f,0x83,0x1b,0x83,0x1b,0x83,0x1b,0x83,0x4b,0x0f,
+0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,
+0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x57,0x01,0x8f,0x0f,0x8f,
+0x0d,0x93,0x0b,0x93,0x0b,0x81,0x09,0x81,0x03,0x81,0x0b,0x81,0x09,0x81,0x03,0x81,
+0x0b,0x81,0x05,0x83,0x05,0x81,0x0b,0x81,0x05,0x83,0x05,0x81,0x0b,0x81,0x03,0x81,
+0x09,0x81,0x0b,0x81,0x03,0x81,0x09,0x81,0x0b,0x93,0x0b,0x93,0x0d,0x8f,0x0f,0x8f,
+0x4d,0x03,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0d,0x83,0x0b,0x81,0x0d,0x83,0x0b,
+0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,
+0x81,0x4b,0x0c,0xc0,0x0f,0x00,0x0c,0xc0,0x0f,0x00,0x0f,0xf0,0x0f,0x00,0x0f,0xf0,
+0x0f,0x00,0x03,0x3c,0x0c,0x00,0x03,0x3c,0x0c,0x00,0x03,0x0f,0x0c,0x00,0x03,0x0f,
+0x0c,0x00,0xc3,0x03,0x0c,0x00,0xc3,0x03,0x0c,0x00,0xff,0x00,0x0f,0x00,0xff,0x00,
+0x0f,0x00,0x3c,0x00,0x0f,0x00,0x3c,0x00,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x0c,0x00,0x03,0x00,0x0c,0x00,0x03,0x00,0x0f,0x00,0x0f,0x00,0x0f,0x00,
+0x0f,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,
+0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0xff,0xff,0x0f,0x00,0xff,0xff,
+0x0f,0x00,0xfc,0xfc,0x03,0x00,0xfc,0xfc,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x00,0x00,0x07,0x83,0x1b,0x83,0x19,0x85,0x19,0x85,0x17,0x83,0x01,0x81,0x17,0x83,
+0x01,0x81,0x15,0x83,0x03,0x81,0x05,0x81,0x0d,0x83,0x03,0x81,0x05,0x81,0x0b,0x93,
+0x0b,0x93,0x0b,0x93,0x0b,0x93,0x15,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x4b,0xff,
+0x03,0x03,0x00,0xff,0x03,0x03,0x00,0xff,0x03,0x0f,0x00,0xff,0x03,0x0f,0x00,0x03,
+0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,
+0x0f,0x0c,0x00,0x03,0x0f,0x0c,0x00,0x03,0xff,0x0f,0x00,0x03,0xff,0x0f,0x00,0x03,
+0xfc,0x03,0x00,0x03,0xfc,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,
+0x8d,0x11,0x8d,0x0f,0x91,0x0d,0x91,0x0b,0x83,0x03,0x81,0x07,0x81,0x0b,0x83,0x03,
+0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,
+0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x13,0x8b,0x13,0x8b,0x15,
+0x87,0x17,0x87,0x4d,0x83,0x1b,0x83,0x1b,0x83,0x1b,0x83,0x1b,0x81,0x09,0x87,0x0b,
+0x81,0x09,0x87,0x0b,0x81,0x07,0x89,0x0b,0x81,0x07,0x89,0x0b,0x81,0x05,0x83,0x13,
+0x81,0x05,0x83,0x13,0x89,0x15,0x89,0x15,0x87,0x17,0x87,0x57,0x01,0x85,0x01,0x87,
+0x0f,0x85,0x01,0x87,0x0d,0x93,0x0b,0x93,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,
+0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,
+0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x93,0x0b,0x93,
+0x0d,0x85,0x01,0x87,0x0f,0x85,0x01,0x87,0x4d,0x01,0x85,0x19,0x85,0x17,0x89,0x07,
+0x81,0x0b,0x89,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,
+0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,
+0x81,0x05,0x83,0x0b,0x81,0x05,0x81,0x05,0x83,0x0b,0x91,0x0d,0x91,0x0f,0x8d,0x11,
+0x8d,0x4f,0x03,0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x11,0x83,
+0x05,0x83,0x4d,0x11,0x81,0x1d,0x81,0x0f,0x83,0x05,0x85,0x0f,0x83,0x05,0x85,0x0f,
+0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x4d,0x09,0x81,0x1d,0x81,0x1b,0x85,0x19,0x85,
+0x17,0x83,0x01,0x83,0x15,0x83,0x01,0x83,0x13,0x83,0x05,0x83,0x11,0x83,0x05,0x83,
+0x0f,0x83,0x09,0x83,0x0d,0x83,0x09,0x83,0x0d,0x81,0x0d,0x81,0x0d,0x81,0x0d,0x81,
+0x4b,0x07,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,
+0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,
+0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,
+0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x4f,0x01,0x81,0x0d,0x81,0x0d,0x81,
+0x0d,0x81,0x0d,0x83,0x09,0x83,0x0d,0x83,0x09,0x83,0x0f,0x83,0x05,0x83,0x11,0x83,
+0x05,0x83,0x13,0x83,0x01,0x83,0x15,0x83,0x01,0x83,0x17,0x85,0x19,0x85,0x1b,0x81,
+0x1d,0x81,0x53,0x01,0x83,0x1b,0x83,0x19,0x85,0x19,0x85,0x19,0x81,0x1d,0x81,0x1d,
+0x81,0x05,0x85,0x01,0x83,0x0b,0x81,0x05,0x85,0x01,0x83,0x0b,0x81,0x03,0x87,0x01,
+0x83,0x0b,0x81,0x03,0x87,0x01,0x83,0x0b,0x87,0x17,0x87,0x19,0x83,0x1b,0x83,0x59,
+0x03,0x8d,0x11,0x8d,0x0f,0x91,0x0d,0x91,0x0d,0x81,0x0d,0x81,0x0d,0x81,0x0d,0x81,
+0x0d,0x81,0x03,0x87,0x01,0x81,0x0d,0x81,0x03,0x87,0x01,0x81,0x0d,0x81,0x03,0x87,
+0x01,0x81,0x0d,0x81,0x03,0x87,0x01,0x81,0x0d,0x8d,0x01,0x81,0x0d,0x8d,0x01,0x81,
+0x0f,0x89,0x15,0x89,0x51,0x05,0x8d,0x11,0x8d,0x0f,0x8f,0x0f,0x8f,0x0d,0x83,0x03,
+0x81,0x15,0x83,0x03,0x81,0x13,0x83,0x05,0x81,0x13,0x83,0x05,0x81,0x15,0x83,0x03,
+0x81,0x15,0x83,0x03,0x81,0x17,0x8f,0x0f,0x8f,0x11,0x8d,0x11,0x8d,0x4b,0x81,0x0f,
+0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x81,0x05,
+0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,
+0x81,0x05,0x81,0x07,0x81,0x0b,0x93,0x0b,0x93,0x0d,0x85,0x01,0x87,0x0f,0x85,0x01,
+0x87,0x4d,0x03,0x8b,0x13,0x8b,0x11,0x8f,0x0f,0x8f,0x0d,0x83,0x0b,0x83,0x0b,0x83,
+0x0b,0x83,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,
+0x0f,0x81,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0d,0x83,0x07,0x83,0x0f,0x83,
+0x07,0x83,0x4d,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x83,0x0b,0x83,0x0b,0x83,
+0x0b,0x83,0x0d,0x8f,0x0f,0x8f,0x11,0x8b,0x13,0x8b,0x4f,0x81,0x0f,0x81,0x0b,0x81,
+0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x81,0x05,0x81,0x07,0x81,
+0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x03,0x85,0x05,0x81,0x0b,0x81,0x03,0x85,
+0x05,0x81,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x85,0x07,0x85,0x0b,0x85,
+0x07,0x85,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,
+0x03,0x85,0x13,0x81,0x03,0x85,0x13,0x83,0x1b,0x83,0x1b,0x85,0x19,0x85,0x59,0x03,
+0x8b,0x13,0x8b,0x11,0x8f,0x0f,0x8f,0x0d,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,
+0x81,0x07,0x81,0x05,0x81,0x0b,0x81,0x07,0x81,0x05,0x81,0x0b,0x81,0x07,0x81,0x05,
+0x81,0x0b,0x81,0x07,0x81,0x05,0x81,0x0b,0x83,0x05,0x87,0x0d,0x83,0x05,0x87,0x0f,
+0x83,0x03,0x89,0x0d,0x83,0x03,0x89,0x4b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x13,
+0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x15,0x93,0x0b,0x93,0x0b,
+0x93,0x0b,0x93,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,
+0x93,0x0b,0x93,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x4b,0x0b,0x85,0x19,0x85,
+0x19,0x87,0x17,0x87,0x1d,0x81,0x1d,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,
+0x0b,0x93,0x0b,0x93,0x0b,0x91,0x0d,0x91,0x0d,0x81,0x1d,0x81,0x5d,0x81,0x0f,0x81,
+0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x13,0x83,0x1b,0x83,
+0x17,0x89,0x15,0x89,0x11,0x87,0x03,0x87,0x0b,0x87,0x03,0x87,0x0b,0x83,0x09,0x85,
+0x0b,0x83,0x09,0x85,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x93,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x1d,0x81,0x1d,0x81,
+0x1b,0x83,0x1b,0x83,0x19,0x85,0x19,0x85,0x4b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x0d,0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x17,0x85,0x19,0x85,0x17,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x93,0x4b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0d,0x85,0x19,0x85,
+0x1b,0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x13,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x4b,0x03,0x8b,0x13,0x8b,0x11,0x8f,0x0f,0x8f,0x0d,0x83,0x0b,0x83,0x0b,0x83,0x0b,
+0x83,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,
+0x83,0x0d,0x8f,0x0f,0x8f,0x11,0x8b,0x13,0x8b,0x4f,0x81,0x0f,0x81,0x0b,0x81,0x0f,
+0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,
+0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x15,0x89,0x15,
+0x89,0x17,0x85,0x19,0x85,0x57,0x01,0x8f,0x0f,0x8f,0x0d,0x93,0x0b,0x93,0x0b,0x81,
+0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0b,0x85,0x0b,0x81,0x0b,0x85,0x0b,0x81,
+0x0d,0x87,0x07,0x81,0x0d,0x87,0x07,0x97,0x07,0x97,0x09,0x8f,0x03,0x81,0x09,0x8f,
+0x03,0x81,0x47,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x15,0x81,0x05,0x83,0x13,0x81,
+0x05,0x83,0x13,0x93,0x0b,0x93,0x0d,0x85,0x03,0x87,0x0d,0x85,0x03,0x87,0x4b,0x3c,
+0xc0,0x03,0x00,0x3c,0xc0,0x03,0x00,0xff,0xc0,0x0f,0x00,0xff,0xc0,0x0f,0x00,0xc3,
+0x03,0x0c,0x00,0xc3,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,0x03,0x0c,0x00,0x03,
+0x0f,0x0c,0x00,0x03,0x0f,0x0c,0x00,0x3f,0xfc,0x0f,0x00,0x3f,0xfc,0x0f,0x00,0x3c,
+0xf0,0x03,0x00,0x3c,0xf0,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x85,
+0x19,0x85,0x19,0x83,0x0d,0x81,0x0b,0x83,0x0d,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,
+0x0b,0x93,0x0b,0x83,0x0d,0x81,0x0b,0x83,0x0d,0x81,0x0b,0x85,0x19,0x85,0x59,0x91,
+0x0d,0x91,0x0d,0x93,0x0b,0x93,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,
+0x1d,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x91,0x0d,0x91,0x4d,0x8d,0x11,0x8d,0x11,0x8f,
+0x0f,0x8f,0x1d,0x83,0x1b,0x83,0x1d,0x83,0x1b,0x83,0x19,0x83,0x1b,0x83,0x0d,0x8f,
+0x0f,0x8f,0x0f,0x8d,0x11,0x8d,0x51,0x8f,0x0f,0x8f,0x0f,0x93,0x0b,0x93,0x19,0x85,
+0x19,0x85,0x15,0x85,0x19,0x85,0x1d,0x85,0x19,0x85,0x0b,0x93,0x0b,0x93,0x0b,0x8f,
+0x0f,0x8f,0x4f,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x87,0x03,0x87,0x0b,0x87,
+0x03,0x87,0x0f,0x8b,0x13,0x8b,0x17,0x83,0x1b,0x83,0x17,0x8b,0x13,0x8b,0x0f,0x87,
+0x03,0x87,0x0b,0x87,0x03,0x87,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x0b,0x83,0x4b,0x87,
+0x17,0x87,0x17,0x89,0x07,0x81,0x0b,0x89,0x07,0x81,0x13,0x8b,0x13,0x8b,0x13,0x8b,
+0x13,0x8b,0x0b,0x89,0x07,0x81,0x0b,0x89,0x07,0x81,0x0b,0x87,0x17,0x87,0x57,0x3f,
+0xc0,0x0f,0x00,0x3f,0xc0,0x0f,0x00,0x0f,0xf0,0x0f,0x00,0x0f,0xf0,0x0f,0x00,0x03,
+0x3c,0x0c,0x00,0x03,0x3c,0x0c,0x00,0x03,0x0f,0x0c,0x00,0x03,0x0f,0x0c,0x00,0xc3,
+0x03,0x0c,0x00,0xc3,0x03,0x0c,0x00,0xff,0x00,0x0f,0x00,0xff,0x00,0x0f,0x00,0x3f,
+0xc0,0x0f,0x00,0x3f,0xc0,0x0f,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x93,
+0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,
+0x0f,0x81,0x0b,0x81,0x0f,0x81,0x4b,0x01,0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x1b,
+0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x1b,0x85,0x19,0x85,0x1b,
+0x85,0x19,0x85,0x4b,0x81,0x0f,0x81,0x09,0x83,0x0f,0x81,0x09,0x83,0x0f,0x81,0x07,
+0x85,0x0f,0x81,0x07,0x97,0x09,0x95,0x09,0x95,0x0b,0x93,0x4b,0x01,0x81,0x1d,0x81,
+0x1b,0x83,0x1b,0x83,0x1b,0x81,0x1d,0x81,0x5d,0x81,0x1d,0x81,0x1d,0x83,0x1b,0x83,
+0x1d,0x81,0x1d,0x81,0x5b,0x15,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x03,
+0x83,0x15,0x81,0x03,0x83,0x15,0x81,0x03,0x83,0x15,0x81,0x03,0x83,0x15,0x81,0x1d,
+0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x47,0x81,0x1d,
+0x81,0x1d,0x81,0x1d,0x81,0x5d,0x0b,0x85,0x19,0x85,0x13,0x81,0x01,0x89,0x11,0x81,
+0x01,0x89,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x81,
+0x01,0x81,0x05,0x81,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x8b,0x13,0x8b,0x15,0x8b,
+0x13,0x8b,0x1d,0x81,0x1d,0x81,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,
+0x0b,0x93,0x0b,0x91,0x0d,0x91,0x13,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x83,
+0x07,0x81,0x11,0x83,0x07,0x81,0x13,0x8b,0x13,0x8b,0x15,0x87,0x17,0x87,0x4d,0x07,
+0x89,0x15,0x89,0x13,0x8d,0x11,0x8d,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,
+0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,
+0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x13,0x81,0x05,0x81,0x15,0x81,0x05,0x81,0x4d,
+0x09,0x87,0x17,0x87,0x15,0x8b,0x13,0x8b,0x11,0x83,0x07,0x81,0x11,0x83,0x07,0x81,
+0x0b,0x81,0x03,0x81,0x09,0x81,0x0b,0x81,0x03,0x81,0x09,0x81,0x0b,0x91,0x0d,0x91,
+0x0d,0x93,0x0b,0x93,0x1d,0x81,0x1d,0x81,0x4b,0x07,0x89,0x15,0x89,0x13,0x8d,0x11,
+0x8d,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x81,0x01,
+0x81,0x05,0x81,0x11,0x81,0x01,0x81,0x05,0x81,0x11,0x81,0x01,0x81,0x05,0x81,0x11,
+0x81,0x01,0x81,0x05,0x81,0x11,0x85,0x03,0x83,0x11,0x85,0x03,0x83,0x13,0x83,0x03,
+0x81,0x15,0x83,0x03,0x81,0x4d,0x07,0x81,0x07,0x81,0x13,0x81,0x07,0x81,0x0d,0x91,
+0x0d,0x91,0x0b,0x93,0x0b,0x93,0x0b,0x81,0x05,0x81,0x07,0x81,0x0b,0x81,0x05,0x81,
+0x07,0x81,0x0b,0x83,0x1b,0x83,0x1d,0x83,0x1b,0x83,0x59,0x07,0x89,0x03,0x81,0x0f,
+0x89,0x03,0x81,0x0d,0x8d,0x01,0x83,0x0b,0x8d,0x01,0x83,0x0b,0x81,0x09,0x81,0x03,
+0x81,0x0b,0x81,0x09,0x81,0x03,0x81,0x0b,0x81,0x09,0x81,0x03,0x81,0x0b,0x81,0x09,
+0x81,0x03,0x81,0x0d,0x91,0x0d,0x91,0x0b,0x91,0x0d,0x91,0x0d,0x81,0x1d,0x81,0x57,
+0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x13,
+0x81,0x1d,0x81,0x1b,0x81,0x1d,0x81,0x1d,0x8d,0x11,0x8d,0x13,0x8b,0x13,0x8b,0x4b,
+0x05,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x0b,0x83,0x01,0x8d,0x0b,0x83,0x01,0x8d,
+0x0b,0x83,0x01,0x8d,0x0b,0x83,0x01,0x8d,0x1d,0x81,0x1d,0x81,0x4b,0x13,0x83,0x1b,
+0x83,0x1b,0x85,0x19,0x85,0x1d,0x81,0x1d,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,
+0x81,0x05,0x83,0x01,0x93,0x05,0x83,0x01,0x93,0x05,0x83,0x01,0x91,0x07,0x83,0x01,
+0x91,0x47,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,
+0x93,0x15,0x83,0x1b,0x83,0x19,0x87,0x17,0x87,0x15,0x83,0x03,0x85,0x11,0x83,0x03,
+0x85,0x11,0x81,0x07,0x83,0x11,0x81,0x07,0x83,0x4b,0x81,0x0f,0x81,0x0b,0x81,0x0f,
+0x81,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x0b,0x93,0x1d,0x81,0x1d,0x81,0x4b,0x05,0x8d,
+0x11,0x8d,0x11,0x8d,0x11,0x8d,0x11,0x83,0x1b,0x83,0x1d,0x8b,0x13,0x8b,0x11,0x83,
+0x1b,0x83,0x1b,0x8d,0x11,0x8d,0x13,0x8b,0x13,0x8b,0x4b,0x05,0x81,0x1d,0x81,0x1d,
+0x8d,0x11,0x8d,0x13,0x8b,0x13,0x8b,0x11,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x1d,
+0x8d,0x11,0x8d,0x13,0x8b,0x13,0x8b,0x4b,0x07,0x89,0x15,0x89,0x13,0x8d,0x11,0x8d,
+0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,
+0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x8d,0x11,0x8d,0x13,0x89,0x15,0x89,
+0x4d,0x05,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x93,0x0b,0x93,0x0d,0x91,0x0d,
+0x91,0x0b,0x81,0x09,0x81,0x03,0x81,0x0b,0x81,0x09,0x81,0x03,0x81,0x0b,0x81,0x09,
+0x81,0x11,0x81,0x09,0x81,0x11,0x8d,0x11,0x8d,0x13,0x89,0x15,0x89,0x4d,0x07,0x89,
+0x15,0x89,0x13,0x8d,0x11,0x8d,0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,
+0x09,0x81,0x03,0x81,0x0b,0x81,0x09,0x81,0x03,0x81,0x0d,0x91,0x0d,0x91,0x0b,0x93,
+0x0b,0x93,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x45,0x05,0x81,0x09,0x81,0x11,
+0x81,0x09,0x81,0x11,0x8d,0x11,0x8d,0x13,0x8b,0x13,0x8b,0x11,0x83,0x07,0x81,0x11,
+0x83,0x07,0x81,0x11,0x81,0x1d,0x81,0x1d,0x83,0x1b,0x83,0x1d,0x83,0x1b,0x83,0x53,
+0x00,0x03,0x03,0x00,0x00,0x03,0x03,0x00,0xc0,0x0f,0x0f,0x00,0xc0,0x0f,0x0f,0x00,
+0xc0,0x3c,0x0c,0x00,0xc0,0x3c,0x0c,0x00,0xc0,0x30,0x0c,0x00,0xc0,0x30,0x0c,0x00,
+0xc0,0xf0,0x0c,0x00,0xc0,0xf0,0x0c,0x00,0xc0,0xc3,0x0f,0x00,0xc0,0xc3,0x0f,0x00,
+0x00,0x03,0x03,0x00,0x00,0x03,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+0x05,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x19,0x8f,0x0f,0x8f,0x0d,0x93,0x0b,0x93,
+0x11,0x81,0x09,0x81,0x11,0x81,0x09,0x81,0x11,0x81,0x07,0x83,0x11,0x81,0x07,0x83,
+0x1b,0x81,0x1d,0x81,0x4d,0x05,0x8b,0x13,0x8b,0x13,0x8d,0x11,0x8d,0x1d,0x81,0x1d,
+0x81,0x1d,0x81,0x1d,0x81,0x11,0x8b,0x13,0x8b,0x13,0x8d,0x11,0x8d,0x1d,0x81,0x1d,
+0x81,0x4b,0x05,0x89,0x15,0x89,0x15,0x8b,0x13,0x8b,0x1d,0x83,0x1b,0x83,0x1b,0x83,
+0x1b,0x83,0x11,0x8b,0x13,0x8b,0x13,0x89,0x15,0x89,0x4f,0x05,0x8b,0x13,0x8b,0x13,
+0x8d,0x11,0x8d,0x1b,0x83,0x1b,0x83,0x17,0x85,0x19,0x85,0x1d,0x83,0x1b,0x83,0x11,
+0x8d,0x11,0x8d,0x11,0x8b,0x13,0x8b,0x4d,0x05,0x81,0x09,0x81,0x11,0x81,0x09,0x81,
+0x11,0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x13,0x89,0x15,0x89,0x17,0x85,0x19,0x85,
+0x17,0x89,0x15,0x89,0x13,0x83,0x05,0x83,0x11,0x83,0x05,0x83,0x11,0x81,0x09,0x81,
+0x11,0x81,0x09,0x81,0x4b,0x05,0x8b,0x05,0x81,0x0b,0x8b,0x05,0x81,0x0b,0x8d,0x03,
+0x81,0x0b,0x8d,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x03,
+0x81,0x17,0x81,0x03,0x81,0x17,0x81,0x01,0x83,0x17,0x81,0x01,0x83,0x0b,0x91,0x0d,
+0x91,0x0d,0x8f,0x0f,0x8f,0x49,0xc0,0x03,0x0f,0x00,0xc0,0x03,0x0f,0x00,0xc0,0xc3,
+0x0f,0x00,0xc0,0xc3,0x0f,0x00,0xc0,0xf0,0x0c,0x00,0xc0,0xf0,0x0c,0x00,0xc0,0x3c,
+0x0c,0x00,0xc0,0x3c,0x0c,0x00,0xc0,0x0f,0x0c,0x00,0xc0,0x0f,0x0c,0x00,0xc0,0x03,
+0x0f,0x00,0xc0,0x03,0x0f,0x00,0xc0,0x00,0x0f,0x00,0xc0,0x00,0x0f,0x00,0x00,0x00,
+0x00,0x00,0x00,0x00,0x00,0x00,0x07,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x17,0x8f,
+0x0f,0x8f,0x0d,0x87,0x01,0x89,0x0b,0x87,0x01,0x89,0x0b,0x81,0x0f,0x81,0x0b,0x81,
+0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x4b,0x87,0x01,0x89,0x0b,0x87,
+0x01,0x89,0x0b,0x87,0x01,0x89,0x0b,0x87,0x01,0x89,0x4b,0x81,0x0f,0x81,0x0b,0x81,
+0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x81,0x0f,0x81,0x0b,0x87,0x01,0x89,0x0b,0x87,
+0x01,0x89,0x0d,0x8f,0x0f,0x8f,0x15,0x81,0x1d,0x81,0x1d,0x81,0x1d,0x81,0x55,0x01,
+0x81,0x1d,0x81,0x1b,0x83,0x1b,0x83,0x1b,0x81,0x1d,0x81,0x1d,0x83,0x1b,0x83,0x1d,
+0x81,0x1d,0x81,0x1b,0x83,0x1b,0x83,0x1b,0x81,0x1d,0x81,0x5d,
+};
@@ -0,0 +1,58 @@
+// ss_small_prop.bdf converted by host/bdf2font: proportional font for
+// oledDrawPropString(), height 8, characters 32 ... 126, 793 bytes
+// (1 characters run-length coded; 570 bytes as fixed 6x8 cells)
+#pragma once
+#include <stdint.h>
+
+static const uint8_t ucSmallPropFont[] = {
+0x08,0x20,0x7e,0x07,0x83,0x00,0x00,0x04,0x01,0x00,0x06,0x05,0x00,0x06,0x0b,0x00,
+0x05,0x11,0x00,0x06,0x16,0x00,0x06,0x1c,0x00,0x03,0x22,0x00,0x03,0x25,0x00,0x03,
+0x28,0x00,0x06,0x2b,0x00,0x06,0x31,0x00,0x03,0x37,0x00,0x06,0x3a,0x00,0x03,0x40,
+0x00,0x06,0x43,0x00,0x06,0x49,0x00,0x04,0x4f,0x00,0x06,0x53,0x00,0x06,0x59,0x00,
+0x06,0x5f,0x00,0x06,0x65,0x00,0x06,0x6b,0x00,0x06,0x71,0x00,0x06,0x77,0x00,0x06,
+0x7d,0x00,0x03,0x83,0x00,0x03,0x86,0x00,0x05,0x89,0x00,0x06,0x8e,0x00,0x05,0x94,
+0x00,0x06,0x99,0x00,0x06,0x9f,0x00,0x06,0xa5,0x00,0x06,0xab,0x00,0x06,0xb1,0x00,
+0x06,0xb7,0x00,0x06,0xbd,0x00,0x06,0xc3,0x00,0x06,0xc9,0x00,0x06,0xcf,0x00,0x04,
+0xd5,0x00,0x06,0xd9,0x00,0x06,0xdf,0x00,0x06,0xe5,0x00,0x06,0xeb,0x00,0x06,0xf1,
+0x00,0x06,0xf7,0x00,0x06,0xfd,0x00,0x06,0x03,0x01,0x06,0x09,0x01,0x06,0x0f,0x01,
+0x06,0x15,0x01,0x06,0x1b,0x01,0x06,0x21,0x01,0x06,0x27,0x01,0x06,0x2d,0x01,0x06,
+0x33,0x01,0x05,0x39,0x01,0x04,0x3e,0x01,0x06,0x42,0x01,0x04,0x48,0x01,0x06,0x4c,
+0x01,0x06,0x52,0x01,0x03,0x58,0x01,0x06,0x5b,0x01,0x06,0x61,0x01,0x06,0x67,0x01,
+0x06,0x6d,0x01,0x06,0x73,0x01,0x05,0x79,0x01,0x06,0x7e,0x01,0x05,0x84,0x01,0x03,
+0x89,0x01,0x05,0x8c,0x01,0x05,0x91,0x01,0x03,0x96,0x01,0x06,0x99,0x01,0x05,0x9f,
+0x01,0x06,0xa4,0x01,0x06,0xaa,0x01,0x06,0xb0,0x01,0x06,0xb6,0x01,0x06,0xbc,0x01,
+0x05,0xc2,0x01,0x05,0xc7,0x01,0x06,0xcc,0x01,0x06,0xd2,0x01,0x05,0xd8,0x01,0x05,
+0xdd,0x01,0x05,0xe2,0x01,0x05,0xe7,0x01,0x02,0xec,0x01,0x05,0xee,0x01,0x05,0xf3,
+0x01,0x17,0x06,0x5f,0x06,0x00,0x07,0x03,0x00,0x07,0x03,0x00,0x24,0x7e,0x24,0x7e,
+0x24,0x00,0x24,0x2b,0x6a,0x12,0x00,0x63,0x13,0x08,0x64,0x63,0x00,0x36,0x49,0x56,
+0x20,0x50,0x00,0x07,0x03,0x00,0x3e,0x41,0x00,0x41,0x3e,0x00,0x08,0x3e,0x1c,0x3e,
+0x08,0x00,0x08,0x08,0x3e,0x08,0x08,0x00,0xe0,0x60,0x00,0x08,0x08,0x08,0x08,0x08,
+0x00,0x60,0x60,0x00,0x20,0x10,0x08,0x04,0x02,0x00,0x3e,0x51,0x49,0x45,0x3e,0x00,
+0x42,0x7f,0x40,0x00,0x62,0x51,0x49,0x49,0x46,0x00,0x22,0x49,0x49,0x49,0x36,0x00,
+0x18,0x14,0x12,0x7f,0x10,0x00,0x2f,0x49,0x49,0x49,0x31,0x00,0x3c,0x4a,0x49,0x49,
+0x30,0x00,0x01,0x71,0x09,0x05,0x03,0x00,0x36,0x49,0x49,0x49,0x36,0x00,0x06,0x49,
+0x49,0x29,0x1e,0x00,0x6c,0x6c,0x00,0xec,0x6c,0x00,0x08,0x14,0x22,0x41,0x00,0x24,
+0x24,0x24,0x24,0x24,0x00,0x41,0x22,0x14,0x08,0x00,0x02,0x01,0x59,0x09,0x06,0x00,
+0x3e,0x41,0x5d,0x55,0x1e,0x00,0x7e,0x11,0x11,0x11,0x7e,0x00,0x7f,0x49,0x49,0x49,
+0x36,0x00,0x3e,0x41,0x41,0x41,0x22,0x00,0x7f,0x41,0x41,0x41,0x3e,0x00,0x7f,0x49,
+0x49,0x49,0x41,0x00,0x7f,0x09,0x09,0x09,0x01,0x00,0x3e,0x41,0x49,0x49,0x7a,0x00,
+0x7f,0x08,0x08,0x08,0x7f,0x00,0x41,0x7f,0x41,0x00,0x30,0x40,0x40,0x40,0x3f,0x00,
+0x7f,0x08,0x14,0x22,0x41,0x00,0x7f,0x40,0x40,0x40,0x40,0x00,0x7f,0x02,0x04,0x02,
+0x7f,0x00,0x7f,0x02,0x04,0x08,0x7f,0x00,0x3e,0x41,0x41,0x41,0x3e,0x00,0x7f,0x09,
+0x09,0x09,0x06,0x00,0x3e,0x41,0x51,0x21,0x5e,0x00,0x7f,0x09,0x09,0x19,0x66,0x00,
+0x26,0x49,0x49,0x49,0x32,0x00,0x01,0x01,0x7f,0x01,0x01,0x00,0x3f,0x40,0x40,0x40,
+0x3f,0x00,0x1f,0x20,0x40,0x20,0x1f,0x00,0x3f,0x40,0x3c,0x40,0x3f,0x00,0x63,0x14,
+0x08,0x14,0x63,0x00,0x07,0x08,0x70,0x08,0x07,0x00,0x71,0x49,0x45,0x43,0x00,0x7f,
+0x41,0x41,0x00,0x02,0x04,0x08,0x10,0x20,0x00,0x41,0x41,0x7f,0x00,0x04,0x02,0x01,
+0x02,0x04,0x00,0x80,0x80,0x80,0x80,0x80,0x00,0x03,0x07,0x00,0x20,0x54,0x54,0x54,
+0x78,0x00,0x7f,0x44,0x44,0x44,0x38,0x00,0x38,0x44,0x44,0x44,0x28,0x00,0x38,0x44,
+0x44,0x44,0x7f,0x00,0x38,0x54,0x54,0x54,0x08,0x00,0x08,0x7e,0x09,0x09,0x00,0x18,
+0xa4,0xa4,0xa4,0x7c,0x00,0x7f,0x04,0x04,0x78,0x00,0x7d,0x40,0x00,0x40,0x80,0x84,
+0x7d,0x00,0x7f,0x10,0x28,0x44,0x00,0x7f,0x40,0x00,0x7c,0x04,0x18,0x04,0x78,0x00,
+0x7c,0x04,0x04,0x78,0x00,0x38,0x44,0x44,0x44,0x38,0x00,0xfc,0x44,0x44,0x44,0x38,
+0x00,0x38,0x44,0x44,0x44,0xfc,0x00,0x44,0x78,0x44,0x04,0x08,0x00,0x08,0x54,0x54,
+0x54,0x20,0x00,0x04,0x3e,0x44,0x24,0x00,0x3c,0x40,0x20,0x7c,0x00,0x1c,0x20,0x40,
+0x20,0x1c,0x00,0x3c,0x60,0x30,0x60,0x3c,0x00,0x6c,0x10,0x10,0x6c,0x00,0x9c,0xa0,
+0x60,0x3c,0x00,0x64,0x54,0x54,0x4c,0x00,0x08,0x3e,0x41,0x41,0x00,0x77,0x00,0x41,
+0x41,0x3e,0x08,0x00,0x02,0x01,0x02,0x01,0x00,
+};
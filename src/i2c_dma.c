@@ -0,0 +1,153 @@
+//
+// I2C DMA transport
+// see i2c_dma.h
+//
+// This library is published under GPL 3.0 license.
+//
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/i2c.h"
+#include "hardware/sync.h"
+
+#include "i2c_dma.h"
+
+// active transfers indexed by their I2C unit
+static I2CDMA *pOwner[2];
+static uint8_t bIrqInstalled[2];
+
+//
+// Finish the transfer of an I2C unit
+//
+static void I2CDMAComplete(I2CDMA *pDMA, i2c_hw_t *hw)
+{
+  hw->intr_mask = 0;
+  hw->dma_cr = 0;
+  pDMA->bBusy = 0;
+  pDMA->pBus->bDMABusy = 0; // the bus is free for the next transaction
+} /* I2CDMAComplete() */
+
+//
+// I2C0_IRQ / I2C1_IRQ handler
+// The DMA channel completes when the last word enters the FIFO, so
+// the transfer is finished only by the STOP after it: the channel is
+// done, the FIFO is empty and the controller is idle. A NACK aborts
+// the transfer, the controller flushes its FIFO.
+//
+static void I2CDMAIrqHandler(void)
+{
+int i;
+I2CDMA *pDMA;
+i2c_hw_t *hw;
+
+  for (i=0; i<2; i++)
+  {
+    pDMA = pOwner[i];
+    if (pDMA == NULL || !pDMA->bBusy)
+      continue;
+    hw = i2c_get_hw(pDMA->pBus->picoI2C);
+    if (hw->intr_stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS)
+    {
+      dma_channel_abort(pDMA->iChan);
+      (void) hw->clr_tx_abrt; // also releases the FIFO
+      (void) hw->clr_stop_det;
+      pDMA->bAbort = 1;
+      I2CDMAComplete(pDMA, hw);
+    }
+    else if (hw->intr_stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS)
+    {
+      (void) hw->clr_stop_det; // acknowledge
+      if (!dma_channel_is_busy(pDMA->iChan) && hw->txflr == 0 &&
+          !(hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+        I2CDMAComplete(pDMA, hw);
+    }
+  }
+  __sev(); // wake up I2CDMAWait() and I2CLock()
+} /* I2CDMAIrqHandler() */
+
+int I2CDMAInit(I2CDMA *pDMA, BBI2C *pBus)
+{
+int iUnit, iIrq;
+
+  if (pDMA == NULL || pBus == NULL) return -1;
+  iUnit = i2c_hw_index(pBus->picoI2C);
+  pDMA->pBus = pBus;
+  pDMA->bBusy = 0;
+  pDMA->bAbort = 0;
+  pDMA->iChan = dma_claim_unused_channel(false);
+  if (pDMA->iChan < 0)
+    return -1;
+  pOwner[iUnit] = pDMA;
+  if (!bIrqInstalled[iUnit])
+  {
+    iIrq = iUnit ? I2C1_IRQ : I2C0_IRQ;
+    irq_add_shared_handler(iIrq, I2CDMAIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(iIrq, true);
+    bIrqInstalled[iUnit] = 1;
+  }
+  return 0;
+} /* I2CDMAInit() */
+
+void I2CDMAFree(I2CDMA *pDMA)
+{
+  if (pDMA == NULL || pDMA->iChan < 0) return;
+  I2CDMAWait(pDMA);
+  pOwner[i2c_hw_index(pDMA->pBus->picoI2C)] = NULL;
+  dma_channel_unclaim(pDMA->iChan);
+  pDMA->iChan = -1;
+} /* I2CDMAFree() */
+
+int I2CDMAStart(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen)
+{
+dma_channel_config c;
+i2c_inst_t *i2c;
+i2c_hw_t *hw;
+
+  if (pDMA == NULL || pDMA->iChan < 0 || pWords == NULL || iLen <= 0)
+    return -1;
+  i2c = pDMA->pBus->picoI2C;
+  hw = i2c_get_hw(i2c);
+  I2CLock(pDMA->pBus); // waits for a transfer in progress
+  pDMA->bBusy = 1;
+  pDMA->bAbort = 0;
+  pDMA->pBus->bDMABusy = 1;
+
+  // the target address can only change while the unit is disabled
+  hw->enable = 0;
+  hw->tar = iAddr;
+  hw->enable = 1;
+  (void) hw->clr_stop_det;
+  (void) hw->clr_tx_abrt;
+  hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+  hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS;
+
+  // memory -> DATA_CMD, paced by the I2C TX DREQ; the 16 bit writes
+  // are replicated to both halves of the register, the upper half is ignored
+  c = dma_channel_get_default_config(pDMA->iChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  dma_channel_configure(pDMA->iChan, &c, &hw->data_cmd, pWords, iLen, true);
+  I2CUnlock(pDMA->pBus);
+  return 0;
+} /* I2CDMAStart() */
+
+int I2CDMABusy(I2CDMA *pDMA)
+{
+  return pDMA->bBusy;
+} /* I2CDMABusy() */
+
+int I2CDMAWait(I2CDMA *pDMA)
+{
+  while (pDMA->bBusy)
+    __wfe();
+  return pDMA->bAbort ? -1 : 0;
+} /* I2CDMAWait() */
+
+int I2CDMATransfer(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen)
+{
+  if (I2CDMAStart(pDMA, iAddr, pWords, iLen) != 0)
+    return -1;
+  return I2CDMAWait(pDMA);
+} /* I2CDMATransfer() */
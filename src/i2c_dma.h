@@ -0,0 +1,74 @@
+//
+// I2C DMA transport
+// Feeds a stream of DATA_CMD words to the TX FIFO of a pico I2C unit
+// with one DMA channel, so the CPU can WFE instead of spinning on the
+// FIFO for every byte. A word holds a data byte in bits 0-7 and the
+// I2CDMA_STOP / I2CDMA_RESTART flags, so one stream may hold several
+// transactions to the same address: the controller sends a STOP after
+// each word with I2CDMA_STOP and a START before the next byte.
+// Completion is signalled by the STOP_DET (or TX_ABRT) interrupt of
+// the I2C unit after the last byte has left the bus.
+//
+// The transfer is serialised with the other users of the BBI2C bus:
+// I2CLock() waits until it has completed.
+//
+// This library is published under GPL 3.0 license.
+//
+#ifndef __I2C_DMA__
+#define __I2C_DMA__
+
+#include "BitBang_I2C.h"
+
+#define I2CDMA_STOP    0x200 // send a STOP after this byte
+#define I2CDMA_RESTART 0x400 // send a RESTART before this byte
+
+typedef struct myi2cdma
+{
+BBI2C * pBus;              // bus of the transfers
+int iChan;                 // claimed DMA channel (-1 = not claimed)
+volatile uint8_t bBusy;    // transfer in progress
+volatile uint8_t bAbort;   // the last transfer was aborted (NACK)
+} I2CDMA;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Claim a DMA channel for the given bus
+// The bus must already be initialized with I2CInit()
+// returns 0 for success, -1 if no DMA channel is available
+//
+int I2CDMAInit(I2CDMA *pDMA, BBI2C *pBus);
+//
+// Release the DMA channel
+//
+void I2CDMAFree(I2CDMA *pDMA);
+//
+// Start sending iLen DATA_CMD words to the device at iAddr and return
+// immediately; the last word should carry I2CDMA_STOP
+// Waits for transfers in progress on the bus first
+// The words must stay valid until I2CDMABusy() returns 0
+// returns 0 for success, -1 for invalid parameter
+//
+int I2CDMAStart(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen);
+//
+// Returns 1 while a transfer is in progress
+//
+int I2CDMABusy(I2CDMA *pDMA);
+//
+// Wait (WFE) until the current transfer has completed
+// returns 0 for success, -1 if the transfer was aborted
+//
+int I2CDMAWait(I2CDMA *pDMA);
+//
+// Start a transfer and wait for it to complete
+// returns 0 for success, -1 for invalid parameter or abort
+//
+int I2CDMATransfer(I2CDMA *pDMA, uint8_t iAddr, const uint16_t *pWords, int iLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__I2C_DMA__
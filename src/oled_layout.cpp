@@ -0,0 +1,113 @@
+/*
+ Class OLEDLayout keeps a screen of static elements and value
+ widgets in the back buffer of a picoSSOLED display.
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "oled_layout.hpp"
+
+OLEDLayout::OLEDLayout(picoSSOLED &oled)
+    : oled(oled), item_count(0), value_count(0) {
+}
+
+bool OLEDLayout::add_text(int x, int row, const char *text, int size, bool invert) {
+    if (item_count >= MAX_ITEMS || size < FONT_6x8 || size > FONT_16x32)
+        return false;
+    items[item_count++] = { TEXT, (int16_t) x, (int16_t) row, 0, 0, text, NULL, (uint8_t) size, invert };
+    return true;
+}
+
+bool OLEDLayout::add_text(int x, int y, const char *text, const uint8_t *font, bool invert) {
+    if (item_count >= MAX_ITEMS || font == NULL)
+        return false;
+    items[item_count++] = { PROP_TEXT, (int16_t) x, (int16_t) y, 0, 0, text, font, 0, invert };
+    return true;
+}
+
+bool OLEDLayout::add_box(int x1, int y1, int x2, int y2, bool filled) {
+    if (item_count >= MAX_ITEMS)
+        return false;
+    items[item_count++] = { BOX, (int16_t) x1, (int16_t) y1, (int16_t) x2, (int16_t) y2, NULL, NULL, 0, filled };
+    return true;
+}
+
+int OLEDLayout::add_value(int x, int row, const char *format, int chars, int size, bool invert) {
+    if (value_count >= MAX_VALUES || chars < 1 || chars > MAX_CHARS || size < FONT_6x8 || size > FONT_16x32)
+        return -1;
+    Value &value = values[value_count];
+    value.x      = (int16_t) x;
+    value.row    = (int16_t) row;
+    value.format = format;
+    value.chars  = (uint8_t) chars;
+    value.size   = (uint8_t) size;
+    value.invert = invert;
+    memset(value.shown, ' ', chars);
+    value.shown[chars] = 0;
+    return value_count++;
+}
+
+void OLEDLayout::write(Value &value, const char *text, int first, int last) {
+    char run[MAX_CHARS + 1];
+    memcpy(run, &text[first], last - first + 1);
+    run[last - first + 1] = 0;
+    oled.write_string(0, value.x + first * OLED_FONT_WIDTH(value.size), value.row, run,
+                      value.size, value.invert, false);
+    memcpy(&value.shown[first], run, last - first + 1);
+}
+
+void OLEDLayout::draw() {
+    oled.fill(0, false);
+    for (int i = 0; i < item_count; i++) {
+        const Item &item = items[i];
+        switch (item.kind) {
+            case TEXT:
+                oled.write_string(0, item.x, item.y, (char *) item.text, item.size, item.invert, false);
+                break;
+            case PROP_TEXT:
+                oled.draw_string(item.x, item.y, (char *) item.text, item.font, item.invert);
+                break;
+            case BOX:
+                oled.draw_rectangle(item.x, item.y, item.x2, item.y2, 1, item.invert);
+                break;
+        }
+    }
+    for (int i = 0; i < value_count; i++)
+        write(values[i], values[i].shown, 0, values[i].chars - 1);
+}
+
+int OLEDLayout::set_text(int id, const char *text) {
+    if (id < 0 || id >= value_count)
+        return -1;
+    Value &value = values[id];
+    // the new text in the fixed width
+    char fitted[MAX_CHARS + 1];
+    int len = strlen(text);
+    for (int i = 0; i < value.chars; i++)
+        fitted[i] = (i < len) ? text[i] : ' ';
+    fitted[value.chars] = 0;
+    // write each run of changed characters with one call
+    int written = 0;
+    for (int i = 0; i < value.chars; i++) {
+        if (fitted[i] == value.shown[i])
+            continue;
+        int last = i;
+        while (last + 1 < value.chars && fitted[last + 1] != value.shown[last + 1])
+            last++;
+        write(value, fitted, i, last);
+        written += last - i + 1;
+        i = last;
+    }
+    return written;
+}
+
+int OLEDLayout::set_value(int id, double value) {
+    if (id < 0 || id >= value_count)
+        return -1;
+    char text[32];
+    snprintf(text, sizeof(text), values[id].format, value);
+    return set_text(id, text);
+}
@@ -0,0 +1,89 @@
+/*
+ Class OLEDLayout keeps a screen of a picoSSOLED display in its back
+ buffer: static texts and boxes, drawn once by draw(), and value
+ widgets of a fixed format. A new value only rewrites the characters
+ that differ from the ones shown, so the back buffer changes in those
+ character cells alone and the next flush() or end_frame() sends just
+ their tiles.
+
+   OLEDLayout layout(oled);
+   layout.add_text(0, 3, "tem:", FONT_8x8);
+   int tem = layout.add_value(40, 3, "%6.1f", 6, FONT_8x8);
+   layout.draw();
+   ...
+   oled.begin_frame();
+   layout.set_value(tem, 21.4);
+   oled.end_frame();
+
+ Works on the back buffer only (set_back_buffer() first).
+
+ (c) 2021, by Michael Stal
+ This library is published under GPL 3.0 license.
+*/
+
+#pragma once
+
+#include "ss_oled.hpp"
+
+class OLEDLayout {
+public:
+    static const int MAX_ITEMS  = 12;   // static texts and boxes
+    static const int MAX_VALUES = 8;
+    static const int MAX_CHARS  = 16;   // characters of a value
+
+    OLEDLayout(picoSSOLED &oled);
+
+    // Static elements, false if the layout is full.
+    // The texts are not copied and must stay valid.
+    // text in a fixed font (FONT_xxx) at column x of text row (page) row
+    bool add_text(int x, int row, const char *text, int size, bool invert = false);
+    // text in a proportional font, top left corner at pixel x,y
+    bool add_text(int x, int y, const char *text, const uint8_t *font, bool invert = false);
+    bool add_box(int x1, int y1, int x2, int y2, bool filled = false);
+
+    // A value shown as chars characters of a fixed font at column x of
+    // text row row, formatted with a printf format for one double
+    // (e.g. "%6.1f"); longer results are cut, shorter ones padded.
+    // Shows blanks until the first set_value().
+    // Returns the id of the value, -1 if the layout is full
+    int add_value(int x, int row, const char *format, int chars, int size, bool invert = false);
+
+    // clears the back buffer, draws the static elements and the values
+    void draw();
+
+    // Writes the characters of the new value that differ from the
+    // shown ones into the back buffer.
+    // Returns the number of characters written, -1 for an invalid id
+    int set_value(int id, double value);
+    // the same with a text instead of the formatted value
+    int set_text(int id, const char *text);
+
+private:
+    enum KIND { TEXT, PROP_TEXT, BOX };
+
+    struct Item {
+        KIND           kind;
+        int16_t        x, y, x2, y2;
+        const char    *text;
+        const uint8_t *font;
+        uint8_t        size;
+        bool           invert;     // BOX: filled
+    };
+
+    struct Value {
+        int16_t     x, row;
+        const char *format;
+        uint8_t     chars, size;
+        bool        invert;
+        char        shown[MAX_CHARS + 1];
+    };
+
+    // writes text[first ... last] of a value
+    void write(Value &value, const char *text, int first, int last);
+
+    picoSSOLED &oled;
+    Item        items[MAX_ITEMS];
+    Value       values[MAX_VALUES];
+    int         item_count;
+    int         value_count;
+};
@@ -0,0 +1,129 @@
+//
+// SPI DMA transport
+// see spi_dma.h
+//
+// This library is published under GPL 3.0 license.
+//
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/spi.h"
+
+#include "spi_dma.h"
+
+// active transfers indexed by their RX channel
+static SPIDMA *pRxOwner[NUM_DMA_CHANNELS];
+static uint8_t bIrqInstalled = 0;
+
+//
+// Shared DMA_IRQ_0 handler: finishes the transfers whose RX channel completed
+//
+static void SPIDMAIrqHandler(void)
+{
+int i;
+SPIDMA *pDMA;
+
+  for (i=0; i<NUM_DMA_CHANNELS; i++)
+  {
+    pDMA = pRxOwner[i];
+    if (pDMA != NULL && (dma_hw->ints0 & (1u << i)))
+    {
+      dma_hw->ints0 = 1u << i; // acknowledge
+      if (pDMA->iCSPin >= 0)
+        gpio_put(pDMA->iCSPin, 1); // all bytes are clocked in, release the device
+      pDMA->bBusy = 0;
+    }
+  }
+  __sev(); // wake up SPIDMAWait()
+} /* SPIDMAIrqHandler() */
+
+int SPIDMAInit(SPIDMA *pDMA, spi_inst_t *spi, int iCSPin)
+{
+  if (pDMA == NULL || spi == NULL) return -1;
+  pDMA->spi = spi;
+  pDMA->iCSPin = iCSPin;
+  pDMA->bBusy = 0;
+  pDMA->ucTxDummy = 0;
+  pDMA->iTxChan = dma_claim_unused_channel(false);
+  pDMA->iRxChan = dma_claim_unused_channel(false);
+  if (pDMA->iTxChan < 0 || pDMA->iRxChan < 0)
+  {
+    SPIDMAFree(pDMA);
+    return -1;
+  }
+  pRxOwner[pDMA->iRxChan] = pDMA;
+  dma_channel_set_irq0_enabled(pDMA->iRxChan, true);
+  if (!bIrqInstalled)
+  {
+    irq_add_shared_handler(DMA_IRQ_0, SPIDMAIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+    bIrqInstalled = 1;
+  }
+  return 0;
+} /* SPIDMAInit() */
+
+void SPIDMAFree(SPIDMA *pDMA)
+{
+  if (pDMA == NULL) return;
+  SPIDMAWait(pDMA);
+  if (pDMA->iRxChan >= 0)
+  {
+    dma_channel_set_irq0_enabled(pDMA->iRxChan, false);
+    pRxOwner[pDMA->iRxChan] = NULL;
+    dma_channel_unclaim(pDMA->iRxChan);
+  }
+  if (pDMA->iTxChan >= 0)
+    dma_channel_unclaim(pDMA->iTxChan);
+  pDMA->iTxChan = pDMA->iRxChan = -1;
+} /* SPIDMAFree() */
+
+int SPIDMAStart(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen)
+{
+dma_channel_config c;
+
+  if (pDMA == NULL || pDMA->iTxChan < 0 || iLen <= 0 || pDMA->bBusy)
+    return -1;
+  pDMA->bBusy = 1;
+
+  // TX: memory -> SPI data register, paced by the SPI TX DREQ
+  c = dma_channel_get_default_config(pDMA->iTxChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_dreq(&c, spi_get_dreq(pDMA->spi, true));
+  channel_config_set_read_increment(&c, pTx != NULL);
+  channel_config_set_write_increment(&c, false);
+  dma_channel_configure(pDMA->iTxChan, &c, &spi_get_hw(pDMA->spi)->dr,
+                        pTx ? pTx : &pDMA->ucTxDummy, iLen, false);
+
+  // RX: SPI data register -> memory; it finishes last, so it signals completion
+  c = dma_channel_get_default_config(pDMA->iRxChan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+  channel_config_set_dreq(&c, spi_get_dreq(pDMA->spi, false));
+  channel_config_set_read_increment(&c, false);
+  channel_config_set_write_increment(&c, pRx != NULL);
+  dma_channel_configure(pDMA->iRxChan, &c, pRx ? pRx : &pDMA->ucRxDummy,
+                        &spi_get_hw(pDMA->spi)->dr, iLen, false);
+
+  if (pDMA->iCSPin >= 0)
+    gpio_put(pDMA->iCSPin, 0); // active low
+  dma_start_channel_mask((1u << pDMA->iTxChan) | (1u << pDMA->iRxChan));
+  return 0;
+} /* SPIDMAStart() */
+
+int SPIDMABusy(SPIDMA *pDMA)
+{
+  return pDMA->bBusy;
+} /* SPIDMABusy() */
+
+void SPIDMAWait(SPIDMA *pDMA)
+{
+  while (pDMA->bBusy)
+    __wfe();
+} /* SPIDMAWait() */
+
+int SPIDMATransfer(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen)
+{
+  if (SPIDMAStart(pDMA, pTx, pRx, iLen) != 0)
+    return -1;
+  SPIDMAWait(pDMA);
+  return 0;
+} /* SPIDMATransfer() */
@@ -0,0 +1,66 @@
+//
+// SPI DMA transport
+// Moves SPI transfers to a pair of DMA channels (one TX, one RX) so
+// the CPU can WFE instead of spinning on the SPI FIFO for every byte.
+// Completion is signalled by the DMA_IRQ_0 interrupt of the RX channel,
+// which also releases the chip select pin if one was given.
+//
+// This library is published under GPL 3.0 license.
+//
+#ifndef __SPI_DMA__
+#define __SPI_DMA__
+
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+
+typedef struct myspidma
+{
+spi_inst_t * spi;          // used pico SPI unit
+int iTxChan, iRxChan;      // claimed DMA channels (-1 = not claimed)
+int iCSPin;                // active low chip select (-1 = handled by the caller)
+volatile uint8_t bBusy;    // transfer in progress
+uint8_t ucTxDummy;         // source of the bytes sent while only reading
+uint8_t ucRxDummy;         // sink for the bytes received while only writing
+} SPIDMA;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Claim two DMA channels for the given SPI unit
+// The SPI unit itself must already be initialized
+// returns 0 for success, -1 if no DMA channels are available
+//
+int SPIDMAInit(SPIDMA *pDMA, spi_inst_t *spi, int iCSPin);
+//
+// Release the DMA channels
+//
+void SPIDMAFree(SPIDMA *pDMA);
+//
+// Start a full duplex transfer of iLen bytes and return immediately
+// pTx == NULL sends zeros, pRx == NULL discards the received bytes
+// pTx and pRx may point to the same buffer
+// The buffers must stay valid until SPIDMABusy() returns 0
+// returns 0 for success, -1 for invalid parameter or busy channel
+//
+int SPIDMAStart(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen);
+//
+// Returns 1 while a transfer is in progress
+//
+int SPIDMABusy(SPIDMA *pDMA);
+//
+// Wait (WFE) until the current transfer has completed
+//
+void SPIDMAWait(SPIDMA *pDMA);
+//
+// Start a transfer and wait for it to complete
+// returns 0 for success, -1 for invalid parameter
+//
+int SPIDMATransfer(SPIDMA *pDMA, const uint8_t *pTx, uint8_t *pRx, int iLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //__SPI_DMA__
@@ -591,11 +591,173 @@ static int16_t pgm_read_word(uint8_t *ptr)
   return ptr[0] + (ptr[1]<<8);
 }
 
+//
+// Start the DMA of the display data queued in the stream (SPI)
+//
+static void __oledSPIStartQueued(SSOLED *pOLED)
+{
+  if (pOLED->iSPIQueued == 0)
+    return;
+  gpio_put(pOLED->iDCPin, 1); // display data
+  SPIDMAStart(&pOLED->spidma, (uint8_t *)pOLED->pu16Stream, NULL, pOLED->iSPIQueued);
+  pOLED->iSPIQueued = 0;
+} /* oledSPIStartQueued() */
+
+//
+// Queue display data in the stream; it is sent by DMA with the
+// next command or at the end of the flush (SPI)
+//
+static void __oledSPIQueue(SSOLED *pOLED, uint8_t *pData, int iLen)
+{
+  if (pOLED->iSPIQueued + iLen > pOLED->iStreamLen * 2) // full: send it first
+    __oledSPIStartQueued(pOLED);
+  if (pOLED->iSPIQueued == 0)
+    SPIDMAWait(&pOLED->spidma); // the stream is free again
+  memcpy((uint8_t *)pOLED->pu16Stream + pOLED->iSPIQueued, pData, iLen);
+  pOLED->iSPIQueued += iLen;
+  pOLED->u32Bytes += iLen;
+} /* oledSPIQueue() */
+
+//
+// Write I2C formatted data to an SPI display: each control byte sets
+// the D/C pin for the bytes that follow it, one of them if its
+// continuation bit (0x80) is set, otherwise all the rest
+//
+static void __oledSPIWrite(SSOLED *pOLED, unsigned char *pData, int iLen)
+{
+int i = 0, iCount;
+unsigned char ucControl;
+
+  __oledSPIStartQueued(pOLED); // keep the order of commands and data
+  SPIDMAWait(&pOLED->spidma); // D/C must not change during a transfer
+  if (pOLED->iCSPin >= 0)
+    gpio_put(pOLED->iCSPin, 0);
+  while (i < iLen)
+  {
+    ucControl = pData[i++];
+    iCount = (ucControl & 0x80) ? 1 : iLen - i;
+    if (iCount > iLen - i)
+      iCount = iLen - i;
+    gpio_put(pOLED->iDCPin, (ucControl & 0x40) != 0);
+    spi_write_blocking(pOLED->pSPI, &pData[i], iCount); // returns when the bytes are out
+    pOLED->u32Bytes += iCount;
+    i += iCount;
+  }
+  if (pOLED->iCSPin >= 0)
+    gpio_put(pOLED->iCSPin, 1);
+} /* oledSPIWrite() */
+
 static void _I2CWrite(SSOLED *pOLED, unsigned char *pData, int iLen)
 {
+  if (pOLED->pSPI != NULL)
+  {
+    __oledSPIWrite(pOLED, pData, iLen);
+    return;
+  }
+  pOLED->u32Bytes += iLen + 1; // + address byte
   I2CWrite(&pOLED->bbi2c, pOLED->oled_addr, pData, iLen);
 } /* _I2CWrite() */
 
+//
+// Mark the tiles (16 columns x 1 page) covering iLen bytes of the
+// back buffer at iOffset as dirty
+//
+static void __oledMarkDirty(SSOLED *pOLED, int iOffset, int iLen)
+{
+  while (iLen > 0)
+  {
+    pOLED->ucDirty[(iOffset >> 7) & 15] |= 1 << ((iOffset >> 4) & 7);
+    iLen -= 16 - (iOffset & 15);
+    iOffset = (iOffset | 15) + 1; // start of the next tile
+  }
+} /* oledMarkDirty() */
+
+//
+// Copy the tiles that match the display into the frame copy, so that
+// oledEndFrame() can drop those that are redrawn unchanged. Pages moved
+// by a running hardware scroll do not match the back buffer.
+//
+static void __oledFrameSnapshot(SSOLED *pOLED)
+{
+int y, iTile, iTiles, iOffset, iLen;
+
+  memset(pOLED->ucFrameClean, 0, sizeof(pOLED->ucFrameClean));
+  if (pOLED->pFrameCopy == NULL)
+    return; // every dirty tile is sent
+  iTiles = (pOLED->oled_x + 15) >> 4;
+  for (y=0; y<(pOLED->oled_y >> 3); y++)
+  {
+    if (pOLED->ucScrollPages & (1 << y))
+      continue;
+    pOLED->ucFrameClean[y] = ~pOLED->ucDirty[y];
+    for (iTile=0; iTile<iTiles; iTile++)
+      if (pOLED->ucFrameClean[y] & (1 << iTile))
+      {
+        iOffset = (y * 128) + (iTile * 16);
+        iLen = pOLED->oled_x - iTile * 16;
+        if (iLen > 16) iLen = 16; // 72 isn't evenly divisible by 16
+        memcpy(&pOLED->pFrameCopy[iOffset], &pOLED->ucScreen[iOffset], iLen);
+      }
+  }
+} /* oledFrameSnapshot() */
+
+//
+// Mark only the tiles whose bytes differ from the new data
+// (call before the data is copied into the back buffer)
+//
+static void __oledMarkChanged(SSOLED *pOLED, int iOffset, unsigned char *pData, int iLen)
+{
+int iChunk;
+
+  while (iLen > 0)
+  {
+    iChunk = 16 - (iOffset & 15); // up to the end of the tile
+    if (iChunk > iLen)
+      iChunk = iLen;
+    if (memcmp(&pOLED->ucScreen[iOffset], pData, iChunk) != 0)
+      __oledMarkDirty(pOLED, iOffset, iChunk);
+    iOffset += iChunk;
+    pData += iChunk;
+    iLen -= iChunk;
+  }
+} /* oledMarkChanged() */
+
+//
+// Set up the SPI unit and the pins of an SPI display and reset it
+// A display cannot be detected on SPI, the controller follows from
+// the display type
+//
+static int __oledInitSPI(SSOLED *pOLED, int32_t iSpeed)
+{
+  spi_init(pOLED->pSPI, iSpeed); // 8 bits, mode 0, MSB first
+  gpio_set_function(pOLED->iSCKPin, GPIO_FUNC_SPI);
+  gpio_set_function(pOLED->iMOSIPin, GPIO_FUNC_SPI);
+  gpio_init(pOLED->iDCPin);
+  gpio_set_dir(pOLED->iDCPin, GPIO_OUT);
+  if (pOLED->iCSPin >= 0)
+  {
+    gpio_init(pOLED->iCSPin);
+    gpio_set_dir(pOLED->iCSPin, GPIO_OUT);
+    gpio_put(pOLED->iCSPin, 1);
+  }
+  pOLED->iSPIQueued = 0;
+  if (pOLED->iResetPin >= 0)
+  {
+    gpio_init(pOLED->iResetPin);
+    gpio_set_dir(pOLED->iResetPin, GPIO_OUT);
+    gpio_put(pOLED->iResetPin, 0); // at least 3us low
+    sleep_ms(1);
+    gpio_put(pOLED->iResetPin, 1);
+    sleep_ms(1);
+  }
+  if (pOLED->oled_type == OLED_132x64)
+    return OLED_SH1106_SPI;
+  if (pOLED->oled_type == OLED_128x128)
+    return OLED_SH1107_SPI;
+  pOLED->bWindow = 1; // has horizontal addressing and column/page ranges
+  return OLED_SSD1306_SPI;
+} /* oledInitSPI() */
+
 //
 // Initializes the OLED controller into "page mode"
 //
@@ -609,49 +771,69 @@ int iType = pOLED->oled_type ;
 
   pOLED->ucScreen = NULL; // reset backbuffer; user must provide one later
   pOLED->oled_wrap = 0; // default - disable text wrap
+  memset(pOLED->ucDirty, 0, sizeof(pOLED->ucDirty));
+  pOLED->u32Bytes = 0;
+  pOLED->ucAddrMode = OLED_ADDR_PAGE; // all init sequences select page addressing
+  pOLED->bWindow = 0;
+  pOLED->ucFrame = 0;
+  memset(pOLED->ucFrameClean, 0, sizeof(pOLED->ucFrameClean));
+  pOLED->pFrameCopy = NULL;
+  pOLED->pGlyphCache = NULL;
+  pOLED->ucStartLine = 0; // all init sequences set line 0
+  pOLED->ucScrollPages = 0;
 
-  I2CInit(&pOLED->bbi2c, iSpeed); // on Linux, SDA = bus number, SCL = device address
-  
-  
-  // find the device address if requested
-  if (iAddr == -1 || iAddr == 0 || iAddr == 0xff) // find it
+  if (pOLED->pSPI != NULL)
   {
-    I2CTest(&pOLED->bbi2c, 0x3c);
-    if (I2CTest(&pOLED->bbi2c, 0x3c))
-       pOLED->oled_addr = 0x3c;
-    else if (I2CTest(&pOLED->bbi2c, 0x3d))
-       pOLED->oled_addr = 0x3d;
-    else
-       return rc; // no display found!
+    rc = __oledInitSPI(pOLED, iSpeed);
+    if (rc == OLED_SH1107_SPI)
+      bFlip = !bFlip; // as on I2C
   }
   else
   {
-    pOLED->oled_addr = iAddr;
-    I2CTest(&pOLED->bbi2c, iAddr);
-    if (!I2CTest(&pOLED->bbi2c, iAddr))
-       return rc; // no display found
-  }
-  // Detect the display controller (SSD1306, SH1107 or SH1106)
-  uint8_t u = 0;
-  I2CReadRegister(&pOLED->bbi2c, pOLED->oled_addr, 0x00, &u, 1); // read the status register
-  u &= 0x0f; // mask off power on/off bit
-  if (u == 0x7 || u == 0xf) // SH1107
-  {
-    pOLED->oled_type = OLED_128x128;
-    rc = OLED_SH1107_3C;
-    bFlip = !bFlip; // SH1107 seems to have this reversed from the usual direction
-  }
-  else if (u == 0x8) // SH1106
-  {
-    rc = OLED_SH1106_3C;
-    pOLED->oled_type = OLED_132x64; // needs to be treated a little differently
-  }
-  else if (u == 3 || u == 6) // 6=128x64 display, 3=smaller
-  {
-    rc = OLED_SSD1306_3C;
+    I2CInit(&pOLED->bbi2c, iSpeed); // on Linux, SDA = bus number, SCL = device address
+  
+  
+    // find the device address if requested
+    if (iAddr == -1 || iAddr == 0 || iAddr == 0xff) // find it
+    {
+      I2CTest(&pOLED->bbi2c, 0x3c);
+      if (I2CTest(&pOLED->bbi2c, 0x3c))
+         pOLED->oled_addr = 0x3c;
+      else if (I2CTest(&pOLED->bbi2c, 0x3d))
+         pOLED->oled_addr = 0x3d;
+      else
+         return rc; // no display found!
+    }
+    else
+    {
+      pOLED->oled_addr = iAddr;
+      I2CTest(&pOLED->bbi2c, iAddr);
+      if (!I2CTest(&pOLED->bbi2c, iAddr))
+         return rc; // no display found
+    }
+    // Detect the display controller (SSD1306, SH1107 or SH1106)
+    uint8_t u = 0;
+    I2CReadRegister(&pOLED->bbi2c, pOLED->oled_addr, 0x00, &u, 1); // read the status register
+    u &= 0x0f; // mask off power on/off bit
+    if (u == 0x7 || u == 0xf) // SH1107
+    {
+      pOLED->oled_type = OLED_128x128;
+      rc = OLED_SH1107_3C;
+      bFlip = !bFlip; // SH1107 seems to have this reversed from the usual direction
+    }
+    else if (u == 0x8) // SH1106
+    {
+      rc = OLED_SH1106_3C;
+      pOLED->oled_type = OLED_132x64; // needs to be treated a little differently
+    }
+    else if (u == 3 || u == 6) // 6=128x64 display, 3=smaller
+    {
+      rc = OLED_SSD1306_3C;
+      pOLED->bWindow = 1; // has horizontal addressing and column/page ranges
+    }
+    if (pOLED->oled_addr == 0x3d)
+       rc++; // return the '3D' version of the type
   }
-  if (pOLED->oled_addr == 0x3d)
-     rc++; // return the '3D' version of the type
 
   if (iType == OLED_128x32 || iType == OLED_96x16)
      _I2CWrite(pOLED,(unsigned char *)oled32_initbuf, sizeof(oled32_initbuf));
@@ -729,6 +911,17 @@ unsigned char buf[3];
   _I2CWrite(pOLED, buf, 3);
 } /* oledWriteCommand2() */
 
+static void __oledWriteCommand3(SSOLED *pOLED, unsigned char c, unsigned char d, unsigned char e)
+{
+unsigned char buf[4];
+
+  buf[0] = 0x00;
+  buf[1] = c;
+  buf[2] = d;
+  buf[3] = e;
+  _I2CWrite(pOLED, buf, 4);
+} /* oledWriteCommand3() */
+
 //
 // Sets the brightness (0=off, 255=brightest)
 //
@@ -750,6 +943,7 @@ int __oledScrollBuffer(SSOLED *pOLED, int iStartCol, int iEndCol, int iStartRow,
     if (iStartRow < 0 || iStartRow > 7 || iEndRow < 0 || iEndRow > 7 || iStartRow > iEndRow)
         return -1;
     
+    __oledSetDirty(pOLED, iStartCol, iStartRow * 8, iEndCol, iEndRow * 8 + 7);
     if (bUp)
     {
         for (row=iStartRow; row<=iEndRow; row++)
@@ -783,16 +977,12 @@ int __oledScrollBuffer(SSOLED *pOLED, int iStartCol, int iEndCol, int iStartRow,
     return 0;
 } /* oledScrollBuffer() */
 //
-// Send commands to position the "cursor" (aka memory write address)
-// to the given row and column
+// Translate a back buffer position to the display RAM of the panel
 //
-static void __oledSetPosition(SSOLED *pOLED, int x, int y, int bRender)
+static void __oledPanelOffset(SSOLED *pOLED, int *px, int *py)
 {
-unsigned char buf[4];
+int x = *px, y = *py;
 
-  pOLED->iScreenOffset = (y*128)+x;
-  if (!bRender)
-      return; // don't send the commands to the OLED if we're not rendering the graphics now
   if (pOLED->oled_type == OLED_64x32) // visible display starts at column 32, row 4
   {
     x += 32; // display is centered in VRAM, so this is always true
@@ -818,13 +1008,178 @@ unsigned char buf[4];
       y += 3;
     }
   }
+  *px = x;
+  *py = y;
+} /* oledPanelOffset() */
+
+//
+// Hardware scrolling of the SSD1306 (SH1106/SH1107 have none)
+//
+static int __oledCanScroll(SSOLED *pOLED)
+{
+  return pOLED->oled_type != OLED_132x64 && pOLED->oled_type != OLED_128x128;
+} /* oledCanScroll() */
+
+//
+// Drawing calls change the back buffer only inside a frame, and while
+// a hardware scroll runs: the SSD1306 takes no display RAM writes then
+//
+static int __oledHoldRAM(SSOLED *pOLED)
+{
+  return pOLED->ucFrame || pOLED->ucScrollPages;
+} /* oledHoldRAM() */
+
+int __oledScrollStart(SSOLED *pOLED, int iDir, int iStartPage, int iEndPage, int iFrames, int iVertical)
+{
+unsigned char ucCmd[12];
+int i = 0, iInterval, x = 0;
+// the interval codes of command 0x26/0x29 for 5,64,128,256,3,4,25,2 frames
+static const int iIntervals[8] = {5, 64, 128, 256, 3, 4, 25, 2};
+
+  if (!__oledCanScroll(pOLED) || iDir < OLED_SCROLL_RIGHT || iDir > OLED_SCROLL_UP_LEFT)
+    return -1;
+  if (iStartPage < 0 || iStartPage > iEndPage || iEndPage >= (pOLED->oled_y >> 3))
+    return -1;
+  if (iVertical < 0 || iVertical > 63 || (iVertical && iDir < OLED_SCROLL_UP_RIGHT))
+    return -1;
+  for (iInterval=0; iInterval<8; iInterval++)
+    if (iIntervals[iInterval] == iFrames)
+      break;
+  if (iInterval == 8)
+    return -1;
+  // the horizontal scroll moves the display RAM itself
+  pOLED->ucScrollPages |= ((1 << (iEndPage - iStartPage + 1)) - 1) << iStartPage;
+  __oledPanelOffset(pOLED, &x, &iStartPage);
+  __oledPanelOffset(pOLED, &x, &iEndPage);
+  ucCmd[i++] = 0x00; // command introducer
+  ucCmd[i++] = 0x2e; // no setup while a scroll is active
+  if (iDir == OLED_SCROLL_RIGHT || iDir == OLED_SCROLL_LEFT)
+    ucCmd[i++] = (iDir == OLED_SCROLL_RIGHT) ? 0x26 : 0x27;
+  else
+    ucCmd[i++] = (iDir == OLED_SCROLL_UP_RIGHT) ? 0x29 : 0x2a;
+  ucCmd[i++] = 0x00; // dummy byte
+  ucCmd[i++] = iStartPage;
+  ucCmd[i++] = iInterval;
+  ucCmd[i++] = iEndPage;
+  if (iDir == OLED_SCROLL_RIGHT || iDir == OLED_SCROLL_LEFT)
+  {
+    ucCmd[i++] = 0x00; // dummy bytes
+    ucCmd[i++] = 0xff;
+  }
+  else
+    ucCmd[i++] = iVertical; // rows per step
+  ucCmd[i++] = 0x2f; // activate
+  _I2CWrite(pOLED, ucCmd, i);
+  return 0;
+} /* oledScrollStart() */
+
+void __oledScrollStop(SSOLED *pOLED)
+{
+unsigned char ucCmd[3];
+int y;
+
+  if (!__oledCanScroll(pOLED))
+    return;
+  ucCmd[0] = 0x00;
+  ucCmd[1] = 0x2e; // deactivate
+  ucCmd[2] = 0x40 | pOLED->ucStartLine; // the vertical part of a scroll moved it
+  _I2CWrite(pOLED, ucCmd, 3);
+  // the RAM of the scrolled pages no longer matches the back buffer:
+  // the next flush rewrites them
+  for (y=0; y<8; y++)
+    if (pOLED->ucScrollPages & (1 << y))
+    {
+      pOLED->ucDirty[y] = 0xff;
+      pOLED->ucFrameClean[y] = 0;
+    }
+  pOLED->ucScrollPages = 0;
+} /* oledScrollStop() */
+
+int __oledSetScrollArea(SSOLED *pOLED, int iTop, int iRows)
+{
+  if (!__oledCanScroll(pOLED) || iTop < 0 || iRows < 1 || iTop + iRows > 64)
+    return -1;
+  __oledWriteCommand3(pOLED, 0xa3, iTop, iRows);
+  return 0;
+} /* oledSetScrollArea() */
+
+int __oledSetStartLine(SSOLED *pOLED, int iLine)
+{
+  if (iLine < 0 || iLine >= ((pOLED->oled_type == OLED_128x128) ? 128 : 64))
+    return -1;
+  if (pOLED->oled_type == OLED_128x128) // SH1107: two byte command
+    __oledWriteCommand2(pOLED, 0xdc, iLine);
+  else
+    __oledWriteCommand(pOLED, 0x40 | iLine);
+  pOLED->ucStartLine = iLine;
+  return 0;
+} /* oledSetStartLine() */
+
+//
+// The commands that move the display RAM pointer to column x of page y
+// The page and column commands work in page addressing mode only, so
+// the controller is switched back to it if a window flush left it in
+// horizontal mode. Returns the number of command bytes (3 or 5)
+//
+static int __oledPositionCommands(SSOLED *pOLED, int x, int y, unsigned char *buf)
+{
+int i = 0;
+
+  __oledPanelOffset(pOLED, &x, &y);
+  if (pOLED->ucAddrMode != OLED_ADDR_PAGE)
+  {
+    buf[i++] = 0x20; // memory addressing mode
+    buf[i++] = OLED_ADDR_PAGE;
+    pOLED->ucAddrMode = OLED_ADDR_PAGE;
+  }
+  buf[i++] = 0xb0 | y; // set page to Y
+  buf[i++] = x & 0xf; // lower column address
+  buf[i++] = 0x10 | (x >> 4); // upper column addr
+  return i;
+} /* oledPositionCommands() */
+
+//
+// Send commands to position the "cursor" (aka memory write address)
+// to the given row and column
+//
+static void __oledSetPosition(SSOLED *pOLED, int x, int y, int bRender)
+{
+unsigned char buf[6];
+
+  pOLED->iScreenOffset = (y*128)+x;
+  if (!bRender || __oledHoldRAM(pOLED))
+      return; // don't send the commands to the OLED if we're not rendering the graphics now
   buf[0] = 0x00; // command introducer
-  buf[1] = 0xb0 | y; // set page to Y
-  buf[2] = x & 0xf; // lower column address
-  buf[3] = 0x10 | (x >> 4); // upper column addr
-  _I2CWrite(pOLED, buf, 4);
+  _I2CWrite(pOLED, buf, 1 + __oledPositionCommands(pOLED, x, y, &buf[1]));
 } /* oledSetPosition() */
 
+//
+// The commands that set a window in horizontal addressing mode
+// (SSD1306 only): columns x1..x2, pages y1..y2 of the back buffer.
+// The data written next fills the window row by row of pages.
+// Returns the number of command bytes (6 or 8)
+//
+static int __oledWindowCommands(SSOLED *pOLED, int x1, int y1, int x2, int y2, unsigned char *buf)
+{
+int i = 0;
+
+  __oledPanelOffset(pOLED, &x1, &y1);
+  __oledPanelOffset(pOLED, &x2, &y2);
+  if (pOLED->ucAddrMode != OLED_ADDR_HORIZONTAL)
+  {
+    buf[i++] = 0x20; // memory addressing mode
+    buf[i++] = OLED_ADDR_HORIZONTAL;
+    pOLED->ucAddrMode = OLED_ADDR_HORIZONTAL;
+  }
+  buf[i++] = 0x21; // column range
+  buf[i++] = x1;
+  buf[i++] = x2;
+  buf[i++] = 0x22; // page range
+  buf[i++] = y1;
+  buf[i++] = y2;
+  return i;
+} /* oledWindowCommands() */
+
 //
 // Write a block of pixel data to the OLED
 // Length can be anything from 1 to 1024 (whole display)
@@ -833,6 +1188,8 @@ static void __oledWriteDataBlock(SSOLED *pOLED, unsigned char *ucBuf, int iLen,
 {
 unsigned char ucTemp[129];
 
+  if (__oledHoldRAM(pOLED)) // drawing calls of a frame or during a scroll go to the back buffer only
+    bRender = 0;
   ucTemp[0] = 0x40; // data command
 // Copying the data has the benefit in SPI mode of not letting
 // the original data get overwritten by the SPI.transfer() function
@@ -844,6 +1201,8 @@ unsigned char ucTemp[129];
   // Keep a copy in local buffer
   if (pOLED->ucScreen)
   {
+    if (!bRender) // the display has yet to get the changes
+      __oledMarkChanged(pOLED, pOLED->iScreenOffset, ucBuf, iLen);
     memcpy(&pOLED->ucScreen[pOLED->iScreenOffset], ucBuf, iLen);
     pOLED->iScreenOffset += iLen;
     pOLED->iScreenOffset &= 1023; // we use a fixed stride of 128 no matter what the display size
@@ -1043,6 +1402,9 @@ void __oledDrawSprite(SSOLED *pOLED, uint8_t *pSprite, int cx, int cy, int iPitc
     }
     if (x + cx > pOLED->oled_x)
         cx = pOLED->oled_x - x;
+    if (cx <= 0 || cy <= 0)
+        return;
+    __oledSetDirty(pOLED, dx, dy, dx + cx - 1, dy + cy - 1);
     for (ty=0; ty<cy; ty++)
     {
         s = &pSprite[iStartX >> 3];
@@ -1188,7 +1550,7 @@ unsigned char uc, ucOld;
 
   if (pOLED->ucScreen)
     uc = ucOld = pOLED->ucScreen[i];
-  else if (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128) // SH1106/SH1107 can read data
+  else if (pOLED->pSPI == NULL && (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128)) // SH1106/SH1107 can read data (not on SPI)
   {
     uint8_t ucTemp[3];
      ucTemp[0] = 0x80; // one command
@@ -1216,7 +1578,7 @@ unsigned char uc, ucOld;
       __oledWriteDataBlock(pOLED, &uc, 1, bRender);
       pOLED->ucScreen[i] = uc;
     }
-    else if (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128) // end the read_modify_write operation
+    else if (pOLED->pSPI == NULL && (pOLED->oled_type == OLED_132x64 || pOLED->oled_type == OLED_128x128)) // end the read_modify_write operation
     {
       uint8_t ucTemp[4];
       ucTemp[0] = 0xc0; // one data
@@ -1327,14 +1689,288 @@ void __oledSetTextWrap(SSOLED *pOLED, int bWrap)
   pOLED->oled_wrap = bWrap;
 } /* oledSetTextWrap() */
 //
+// Width in columns and height in pages of the glyphs of each font size
+//
+static const uint8_t ucGlyphWidth[] = {6, 8, 12, 16, 16};
+static const uint8_t ucGlyphPages[] = {1, 1, 2, 2, 4};
+//
+// Stretch a glyph of iCols columns to double width and height
+// pGlyph receives the top page (2*iCols columns), then the bottom page
+//
+static void __oledStretchGlyph(uint8_t *pSrc, int iCols, uint8_t *pGlyph)
+{
+int tx, ty;
+uint8_t c, uc1, uc2, ucMask, *pDest;
+
+    for (tx=0; tx<iCols; tx++)
+    {
+        ucMask = 3;
+        pDest = &pGlyph[tx*2];
+        uc1 = uc2 = 0;
+        c = pSrc[tx];
+        for (ty=0; ty<4; ty++)
+        {
+            if (c & (1 << ty)) // a bit is set
+                uc1 |= ucMask;
+            if (c & (1 << (ty + 4)))
+                uc2 |= ucMask;
+            ucMask <<= 2;
+        }
+        pDest[0] = uc1;
+        pDest[1] = uc1; // double width
+        pDest[iCols*2] = uc2;
+        pDest[iCols*2+1] = uc2;
+    }
+} /* oledStretchGlyph() */
+//
+// Prepare the glyph of character c as it is sent to the display:
+// OLED_GLYPH_BYTES(iSize) bytes, page by page, with the blank first
+// column of the small fonts, stretched and inverted as requested
+//
+static void __oledExpandGlyph(int iSize, unsigned char c, int bInvert, uint8_t *pGlyph)
+{
+int tx, ty;
+uint8_t ucSrc[8], ucMask, *pDest;
+
+    c -= 32;
+    if (iSize == FONT_8x8)
+    {
+        // we can't directly use the pointer to FLASH memory, so copy to a local buffer
+        pGlyph[0] = 0;
+        memcpy(&pGlyph[1], &ucFont[(int)c*7], 7);
+        if (bInvert) __InvertBytes(pGlyph, 8);
+    }
+    else if (iSize == FONT_6x8)
+    {
+        pGlyph[0] = 0;
+        memcpy(&pGlyph[1], &ucSmallFont[(int)c*5], 5);
+        if (bInvert) __InvertBytes(pGlyph, 6);
+    }
+#ifndef __AVR__
+    else if (iSize == FONT_16x32)
+    {
+        memcpy(pGlyph, &ucBigFont[(int)c*64], 64);
+        if (bInvert) __InvertBytes(pGlyph, 64);
+    }
+#endif // !__AVR__
+    else if (iSize == FONT_16x16) // 8x8 stretched to 16x16
+    {
+        ucSrc[0] = 0;
+        memcpy(&ucSrc[1], &ucFont[(int)c*7], 7);
+        if (bInvert) __InvertBytes(ucSrc, 8);
+        __oledStretchGlyph(ucSrc, 8, pGlyph);
+    }
+    else if (iSize == FONT_12x16) // 6x8 stretched to 12x16
+    {
+        ucSrc[0] = 0; // first column is blank
+        memcpy(&ucSrc[1], &ucSmallFont[(int)c*5], 5);
+        if (bInvert) __InvertBytes(ucSrc, 6);
+        __oledStretchGlyph(ucSrc, 6, pGlyph);
+        // smooth the diagonal lines
+        for (tx=0; tx<5; tx++)
+        {
+            uint8_t c0, c1, ucMask2;
+            c0 = ucSrc[tx];
+            c1 = ucSrc[tx+1];
+            pDest = &pGlyph[tx*2];
+            ucMask = 1;
+            ucMask2 = 2;
+            for (ty=0; ty<7; ty++)
+            {
+                if (((c0 & ucMask) && !(c1 & ucMask) && !(c0 & ucMask2) && (c1 & ucMask2)) || (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2)))
+                {
+                    if (ty < 3) // top half
+                    {
+                        pDest[1] |= (1 << ((ty * 2)+1));
+                        pDest[2] |= (1 << ((ty * 2)+1));
+                        pDest[1] |= (1 << ((ty+1) * 2));
+                        pDest[2] |= (1 << ((ty+1) * 2));
+                    }
+                    else if (ty == 3) // on the border
+                    {
+                        pDest[1] |= 0x80; pDest[2] |= 0x80;
+                        pDest[13] |= 1; pDest[14] |= 1;
+                    }
+                    else // bottom half
+                    {
+                        pDest[13] |= (1 << (2*(ty-4)+1));
+                        pDest[14] |= (1 << (2*(ty-4)+1));
+                        pDest[13] |= (1 << ((ty-3) * 2));
+                        pDest[14] |= (1 << ((ty-3) * 2));
+                    }
+                }
+                else if (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2))
+                {
+                    if (ty < 4) // top half
+                    {
+                        pDest[1] |= (1 << ((ty * 2)+1));
+                        pDest[2] |= (1 << ((ty+1) * 2));
+                    }
+                    else
+                    {
+                        pDest[13] |= (1 << (2*(ty-4)+1));
+                        pDest[14] |= (1 << ((ty-3) * 2));
+                    }
+                }
+                ucMask <<= 1; ucMask2 <<= 1;
+            }
+        }
+    }
+} /* oledExpandGlyph() */
+//
+// Prepare a glyph cache for one font size and color in the
+// buffer provided by the caller
+// returns the number of glyphs it holds, -1 for invalid parameters
+//
+int __oledGlyphCacheInit(OLEDGLYPHS *pCache, int iSize, int bInvert, uint8_t *pBuffer, int iLen)
+{
+int iSlots;
+
+   if (pCache == NULL || pBuffer == NULL || iSize < FONT_6x8 || iSize > FONT_16x32)
+      return -1;
+#ifdef __AVR__
+   if (iSize == FONT_16x32)
+      return -1;
+#endif
+   iSlots = iLen / OLED_GLYPH_BYTES(iSize);
+   if (iSlots > OLED_GLYPH_CHARS)
+      iSlots = OLED_GLYPH_CHARS; // one slot per character at most
+   if (iSlots <= 0)
+      return -1;
+   memset(pCache, 0, sizeof(OLEDGLYPHS));
+   pCache->pGlyphs = pBuffer;
+   pCache->iSize = (uint8_t)iSize;
+   pCache->bInvert = (uint8_t)(bInvert != 0);
+   pCache->iBytes = OLED_GLYPH_BYTES(iSize);
+   pCache->iSlots = (uint8_t)iSlots;
+   return iSlots;
+} /* oledGlyphCacheInit() */
+//
+// Slot for a new glyph: a free one, otherwise the next one
+// after the preloaded glyphs in turn; -1 if all are preloaded
+//
+static int __oledGlyphCacheSlot(OLEDGLYPHS *pCache)
+{
+int iSlot;
+
+   if (pCache->iUsed < pCache->iSlots)
+      return pCache->iUsed++;
+   if (pCache->iPinned >= pCache->iSlots)
+      return -1;
+   iSlot = pCache->iNext;
+   pCache->iNext = (iSlot + 1 < pCache->iSlots) ? iSlot + 1 : pCache->iPinned;
+   pCache->ucSlot[pCache->ucChar[iSlot]] = 0; // evict its character
+   return iSlot;
+} /* oledGlyphCacheSlot() */
+//
+// Returns the glyph of character c, from the cache if it has one
+// (and put it there on a miss), otherwise expanded into pTemp
+//
+static uint8_t * __oledGetGlyph(OLEDGLYPHS *pCache, int iSize, unsigned char c, int bInvert, uint8_t *pTemp)
+{
+int iSlot;
+uint8_t *pGlyph;
+
+   if (pCache != NULL && c >= 32 && c < 32 + OLED_GLYPH_CHARS)
+   {
+      iSlot = pCache->ucSlot[c - 32];
+      if (iSlot != 0)
+      {
+         pCache->u32Hits++;
+         return &pCache->pGlyphs[(iSlot - 1) * pCache->iBytes];
+      }
+      pCache->u32Misses++;
+      iSlot = __oledGlyphCacheSlot(pCache);
+      if (iSlot >= 0)
+      {
+         pGlyph = &pCache->pGlyphs[iSlot * pCache->iBytes];
+         __oledExpandGlyph(iSize, c, bInvert, pGlyph);
+         pCache->ucSlot[c - 32] = (uint8_t)(iSlot + 1);
+         pCache->ucChar[iSlot] = c - 32;
+         return pGlyph;
+      }
+   }
+   __oledExpandGlyph(iSize, c, bInvert, pTemp);
+   return pTemp;
+} /* oledGetGlyph() */
+//
+// Expand the glyphs of a declared character set and keep them
+// returns 0 for success, -1 if not all of them fit
+//
+int __oledGlyphCachePreload(OLEDGLYPHS *pCache, char *szChars)
+{
+int rc = 0;
+unsigned char c;
+uint8_t *pGlyph;
+
+   if (pCache == NULL || szChars == NULL)
+      return -1;
+   while ((c = (unsigned char)*szChars++) != 0)
+   {
+      if (c < 32 || c >= 32 + OLED_GLYPH_CHARS)
+      {
+         rc = -1; // never cached
+         continue;
+      }
+      if (pCache->ucSlot[c - 32] != 0)
+         continue; // already there
+      if (pCache->iUsed >= pCache->iSlots)
+      {
+         rc = -1;
+         continue;
+      }
+      pGlyph = &pCache->pGlyphs[pCache->iUsed * pCache->iBytes];
+      __oledExpandGlyph(pCache->iSize, c, pCache->bInvert, pGlyph);
+      pCache->ucChar[pCache->iUsed] = c - 32;
+      pCache->ucSlot[c - 32] = ++pCache->iUsed;
+   }
+   pCache->iPinned = pCache->iUsed; // the glyphs cached so far stay
+   pCache->iNext = pCache->iPinned;
+   return rc;
+} /* oledGlyphCachePreload() */
+//
+// Attach a glyph cache to the display / detach it again
+//
+void __oledAddGlyphCache(SSOLED *pOLED, OLEDGLYPHS *pCache)
+{
+   __oledRemoveGlyphCache(pOLED, pCache);
+   pCache->pNext = pOLED->pGlyphCache;
+   pOLED->pGlyphCache = pCache;
+} /* oledAddGlyphCache() */
+
+void __oledRemoveGlyphCache(SSOLED *pOLED, OLEDGLYPHS *pCache)
+{
+OLEDGLYPHS **ppCache = &pOLED->pGlyphCache;
+
+   while (*ppCache != NULL)
+   {
+      if (*ppCache == pCache)
+      {
+         *ppCache = pCache->pNext;
+         pCache->pNext = NULL;
+         return;
+      }
+      ppCache = &(*ppCache)->pNext;
+   }
+} /* oledRemoveGlyphCache() */
+//
 // Draw a string of normal (8x8), small (6x8) or large (16x32) characters
 // At the given col+row
+// The glyphs come from an attached cache of the font size and color
+// if there is one, otherwise they are prepared for each character
 //
 int __oledWriteString(SSOLED *pOLED, int iScroll, int x, int y, char *szMsg, int iSize, int bInvert, int bRender)
 {
-int i, iFontOff, iLen, iFontSkip;
-unsigned char c, *s, ucTemp[40];
+int i, p, iLen, iFontSkip, iWidth, iPages;
+unsigned char *s, ucTemp[64];
+OLEDGLYPHS *pCache;
 
+    if (iSize < FONT_6x8 || iSize > FONT_16x32)
+       return -1; // invalid size
+#ifdef __AVR__
+    if (iSize == FONT_16x32)
+       return -1;
+#endif
     if (x == -1 || y == -1) // use the cursor position
     {
       x = pOLED->iCursorX; y = pOLED->iCursorY;
@@ -1346,293 +1982,148 @@ unsigned char c, *s, ucTemp[40];
     if (pOLED->iCursorX >= pOLED->oled_x || pOLED->iCursorY >= pOLED->oled_y / 8)
        return -1; // can't draw off the display
 
+    iWidth = ucGlyphWidth[iSize];
+    iPages = ucGlyphPages[iSize];
+    pCache = pOLED->pGlyphCache;
+    while (pCache != NULL && (pCache->iSize != iSize || pCache->bInvert != (bInvert != 0)))
+       pCache = pCache->pNext;
+
     __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-    if (iSize == FONT_8x8) // 8x8 font
-    {
-       i = 0;
-       iFontSkip = iScroll & 7; // number of columns to initially skip
-       while (pOLED->iCursorX < pOLED->oled_x && szMsg[i] != 0 && pOLED->iCursorY < pOLED->oled_y / 8)
-       {
-         if (iScroll < 8) // only display visible characters
-         {
-             c = (unsigned char)szMsg[i];
-             iFontOff = (int)(c-32) * 7;
-             // we can't directly use the pointer to FLASH memory, so copy to a local buffer
-             ucTemp[0] = 0;
-             memcpy(&ucTemp[1], &ucFont[iFontOff], 7);
-             if (bInvert) __InvertBytes(ucTemp, 8);
-    //         oledCachedWrite(ucTemp, 8);
-             iLen = 8 - iFontSkip;
-             if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                 iLen = pOLED->oled_x - pOLED->iCursorX;
-             __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-             pOLED->iCursorX += iLen;
-             if (pOLED->iCursorX >= pOLED->oled_x-7 && pOLED->oled_wrap) // word wrap enabled?
-             {
-               pOLED->iCursorX = 0; // start at the beginning of the next line
-               pOLED->iCursorY++;
-               __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-             }
-             iFontSkip = 0;
-         }
-         iScroll -= 8;
-         i++;
-       } // while
-//     oledCachedFlush(); // write any remaining data
-       return 0;
-    } // 8x8
-#ifndef __AVR__
-    else if (iSize == FONT_16x32) // 16x32 font
-    {
-      i = 0;
-      iFontSkip = iScroll & 15; // number of columns to initially skip
-      while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y / 8)-3 && szMsg[i] != 0)
-      {
-          if (iScroll < 16) // if characters are visible
-          {
-              s = (unsigned char *)&ucBigFont[(unsigned char)(szMsg[i]-32)*64];
-              iLen = 16 - iFontSkip;
-              if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                  iLen = pOLED->oled_x - pOLED->iCursorX;
-              // we can't directly use the pointer to FLASH memory, so copy to a local buffer
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              memcpy(ucTemp, s, 16);
-              if (bInvert) __InvertBytes(ucTemp, 16);
-              __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+1, bRender);
-              memcpy(ucTemp, s+16, 16);
-              if (bInvert) __InvertBytes(ucTemp, 16);
-              __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-              if (pOLED->iCursorY <= 5)
-              {
-                 __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+2, bRender);
-                 memcpy(ucTemp, s+32, 16);
-                 if (bInvert) __InvertBytes(ucTemp, 16);
-                 __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-              }
-              if (pOLED->iCursorY <= 4)
-              {
-                 __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+3, bRender);
-                 memcpy(ucTemp, s+48, 16);
-                 if (bInvert) __InvertBytes(ucTemp, 16);
-                 __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-              }
-              pOLED->iCursorX += iLen;
-              if (pOLED->iCursorX >= pOLED->oled_x-15 && pOLED->oled_wrap) // word wrap enabled?
-              {
-                pOLED->iCursorX = 0; // start at the beginning of the next line
-                pOLED->iCursorY+=4;
-              }
-              iFontSkip = 0;
-          } // if character visible from scrolling
-          iScroll -= 16;
-          i++;
-       } // while
-       return 0;
-    } // 16x32
-#endif // !__AVR__
-    else if (iSize == FONT_12x16) // 6x8 stretched to 12x16
-    {
-      i = 0;
-      iFontSkip = iScroll % 12; // number of columns to initially skip
-      while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8)-1 && szMsg[i] != 0)
-      {
-// stretch the 'normal' font instead of using the big font
-          if (iScroll < 12) // if characters are visible
-          {
-              int tx, ty;
-              c = szMsg[i] - 32;
-              unsigned char uc1, uc2, ucMask, *pDest;
-              s = (unsigned char *)&ucSmallFont[(int)c*5];
-              ucTemp[0] = 0; // first column is blank
-              memcpy(&ucTemp[1], s, 6);
-              if (bInvert)
-                  __InvertBytes(ucTemp, 6);
-              // Stretch the font to double width + double height
-              memset(&ucTemp[6], 0, 24); // write 24 new bytes
-              for (tx=0; tx<6; tx++)
-              {
-                  ucMask = 3;
-                  pDest = &ucTemp[6+tx*2];
-                  uc1 = uc2 = 0;
-                  c = ucTemp[tx];
-                  for (ty=0; ty<4; ty++)
-                  {
-                      if (c & (1 << ty)) // a bit is set
-                          uc1 |= ucMask;
-                      if (c & (1 << (ty + 4)))
-                          uc2 |= ucMask;
-                      ucMask <<= 2;
-                  }
-                  pDest[0] = uc1;
-                  pDest[1] = uc1; // double width
-                  pDest[12] = uc2;
-                  pDest[13] = uc2;
-              }
-              // smooth the diagonal lines
-              for (tx=0; tx<5; tx++)
-              {
-                  uint8_t c0, c1, ucMask2;
-                  c0 = ucTemp[tx];
-                  c1 = ucTemp[tx+1];
-                  pDest = &ucTemp[6+tx*2];
-                  ucMask = 1;
-                  ucMask2 = 2;
-                  for (ty=0; ty<7; ty++)
-                  {
-                      if (((c0 & ucMask) && !(c1 & ucMask) && !(c0 & ucMask2) && (c1 & ucMask2)) || (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2)))
-                      {
-                          if (ty < 3) // top half
-                          {
-                              pDest[1] |= (1 << ((ty * 2)+1));
-                              pDest[2] |= (1 << ((ty * 2)+1));
-                              pDest[1] |= (1 << ((ty+1) * 2));
-                              pDest[2] |= (1 << ((ty+1) * 2));
-                          }
-                          else if (ty == 3) // on the border
-                          {
-                              pDest[1] |= 0x80; pDest[2] |= 0x80;
-                              pDest[13] |= 1; pDest[14] |= 1;
-                          }
-                          else // bottom half
-                          {
-                              pDest[13] |= (1 << (2*(ty-4)+1));
-                              pDest[14] |= (1 << (2*(ty-4)+1));
-                              pDest[13] |= (1 << ((ty-3) * 2));
-                              pDest[14] |= (1 << ((ty-3) * 2));
-                          }
-                      }
-                      else if (!(c0 & ucMask) && (c1 & ucMask) && (c0 & ucMask2) && !(c1 & ucMask2))
-                      {
-                          if (ty < 4) // top half
-                          {
-                              pDest[1] |= (1 << ((ty * 2)+1));
-                              pDest[2] |= (1 << ((ty+1) * 2));
-                          }
-                          else
-                          {
-                              pDest[13] |= (1 << (2*(ty-4)+1));
-                              pDest[14] |= (1 << ((ty-3) * 2));
-                          }
-                      }
-                      ucMask <<= 1; ucMask2 <<= 1;
-                  }
-              }
-              iLen = 12 - iFontSkip;
-              if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                  iLen = pOLED->oled_x - pOLED->iCursorX;
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              __oledWriteDataBlock(pOLED, &ucTemp[6+iFontSkip], iLen, bRender);
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+1, bRender);
-              __oledWriteDataBlock(pOLED, &ucTemp[18+iFontSkip], iLen, bRender);
-              pOLED->iCursorX += iLen;
-              if (pOLED->iCursorX >= pOLED->oled_x-11 && pOLED->oled_wrap) // word wrap enabled?
-              {
-                  pOLED->iCursorX = 0; // start at the beginning of the next line
-                  pOLED->iCursorY += 2;
-                __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              }
-              iFontSkip = 0;
-          } // if characters are visible
-          iScroll -= 12;
-          i++;
-      } // while
-      return 0;
-    } // 12x16
-    else if (iSize == FONT_16x16) // 8x8 stretched to 16x16
-    {
-      i = 0;
-      iFontSkip = iScroll & 15; // number of columns to initially skip
-      while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8)-1 && szMsg[i] != 0)
-      {   
-// stretch the 'normal' font instead of using the big font
-          if (iScroll < 16) // if characters are visible
-          {
-              int tx, ty;
-              c = szMsg[i] - 32;
-              unsigned char uc1, uc2, ucMask, *pDest;
-              s = (unsigned char *)&ucFont[(int)c*7];
-              ucTemp[0] = 0;
-              memcpy(&ucTemp[1], s, 7);
-              if (bInvert)
-                  __InvertBytes(ucTemp, 8);
-              // Stretch the font to double width + double height
-              memset(&ucTemp[8], 0, 32); // write 32 new bytes
-              for (tx=0; tx<8; tx++)
-              {
-                  ucMask = 3;
-                  pDest = &ucTemp[8+tx*2];
-                  uc1 = uc2 = 0;
-                  c = ucTemp[tx];
-                  for (ty=0; ty<4; ty++)
-                  {
-                      if (c & (1 << ty)) // a bit is set
-                          uc1 |= ucMask;
-                      if (c & (1 << (ty + 4)))
-                          uc2 |= ucMask;
-                      ucMask <<= 2;
-                  }
-                  pDest[0] = uc1;
-                  pDest[1] = uc1; // double width
-                  pDest[16] = uc2;
-                  pDest[17] = uc2;
-              }
-              iLen = 16 - iFontSkip;
-              if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                  iLen = pOLED->oled_x - pOLED->iCursorX;
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              __oledWriteDataBlock(pOLED, &ucTemp[8+iFontSkip], iLen, bRender);
-              __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+1, bRender);
-              __oledWriteDataBlock(pOLED, &ucTemp[24+iFontSkip], iLen, bRender);
-              pOLED->iCursorX += iLen;
-              if (pOLED->iCursorX >= pOLED->oled_x-15 && pOLED->oled_wrap) // word wrap enabled?
-              {
-                pOLED->iCursorX = 0; // start at the beginning of the next line
-                pOLED->iCursorY += 2;
-                __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-              }
-              iFontSkip = 0;
-          } // if characters are visible
-          iScroll -= 16;
-          i++;
-      } // while
-      return 0;
-    } // 16x16
-    else if (iSize == FONT_6x8) // 6x8 font
+    i = 0;
+    iFontSkip = iScroll % iWidth; // number of columns to initially skip
+    while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8)-(iPages-1) && szMsg[i] != 0)
     {
-       i = 0;
-       iFontSkip = iScroll % 6;
-       while (pOLED->iCursorX < pOLED->oled_x && pOLED->iCursorY < (pOLED->oled_y/8) && szMsg[i] != 0)
+       if (iScroll < iWidth) // if characters are visible
        {
-           if (iScroll < 6) // if characters are visible
+           s = __oledGetGlyph(pCache, iSize, (unsigned char)szMsg[i], bInvert, ucTemp);
+           iLen = iWidth - iFontSkip;
+           if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
+               iLen = pOLED->oled_x - pOLED->iCursorX;
+           if (iPages == 1)
+               __oledWriteDataBlock(pOLED, &s[iFontSkip], iLen, bRender); // write character pattern
+           else for (p=0; p<iPages; p++)
            {
-               c = szMsg[i] - 32;
-               // we can't directly use the pointer to FLASH memory, so copy to a local buffer
-               ucTemp[0] = 0;
-               memcpy(&ucTemp[1], &ucSmallFont[(int)c*5], 5);
-               if (bInvert) __InvertBytes(ucTemp, 6);
-               iLen = 6 - iFontSkip;
-               if (pOLED->iCursorX + iLen > pOLED->oled_x) // clip right edge
-                   iLen = pOLED->oled_x - pOLED->iCursorX;
-               __oledWriteDataBlock(pOLED, &ucTemp[iFontSkip], iLen, bRender); // write character pattern
-    //         oledCachedWrite(ucTemp, 6);
-               pOLED->iCursorX += iLen;
-               iFontSkip = 0;
-               if (pOLED->iCursorX >= pOLED->oled_x-5 && pOLED->oled_wrap) // word wrap enabled?
-               {
-                 pOLED->iCursorX = 0; // start at the beginning of the next line
-                 pOLED->iCursorY++;
-                 __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
-               }
-           } // if characters are visible
-         iScroll -= 6;
-         i++;
-       }
-//    oledCachedFlush(); // write any remaining data      
-      return 0;
-    } // 6x8
-  return -1; // invalid size
+               __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY+p, bRender);
+               __oledWriteDataBlock(pOLED, &s[p*iWidth + iFontSkip], iLen, bRender);
+           }
+           pOLED->iCursorX += iLen;
+           if (pOLED->iCursorX >= pOLED->oled_x-(iWidth-1) && pOLED->oled_wrap) // word wrap enabled?
+           {
+             pOLED->iCursorX = 0; // start at the beginning of the next line
+             pOLED->iCursorY += iPages;
+             if (iPages == 1) // taller glyphs position each of their pages
+                __oledSetPosition(pOLED, pOLED->iCursorX, pOLED->iCursorY, bRender);
+           }
+           iFontSkip = 0;
+       } // if characters are visible
+       iScroll -= iWidth;
+       i++;
+    } // while
+    return 0;
 } /* oledWriteString() */
+//
+// Decode the columns of one glyph of a proportional font and copy
+// each of them into the back buffer at x, shifted down to row y
+// across up to 5 pages; parts off the display are clipped
+//
+static void __oledBlitPropGlyph(SSOLED *pOLED, const uint8_t *pFont, const uint8_t *pEntry, int x, int y, int bInvert)
+{
+int tx, ty, n, iWidth, iHeight, iBits, iRun, iPage, iPage0, iShift;
+uint32_t u32Col, u32Mask;
+uint64_t u64Col, u64Mask, u64Bits;
+const uint8_t *s;
+uint8_t *d, ucMask, ucRun = 0;
+
+  iHeight = pFont[0];
+  iWidth = pEntry[0] & 0x7f;
+  s = &pFont[OLED_PROP_HEADER + (pFont[2] - pFont[1] + 1) * OLED_PROP_ENTRY + pEntry[1] + (pEntry[2] << 8)];
+  u32Mask = 0xffffffff >> (32 - iHeight);
+  iPage0 = y >> 3; // rounds down, also for y < 0
+  iShift = y & 7;
+  u64Mask = (uint64_t)u32Mask << iShift;
+  u64Bits = 0; // bits read ahead
+  iBits = iRun = 0;
+  for (tx=0; tx<iWidth && x < pOLED->oled_x; tx++, x++)
+  {
+     if (pEntry[0] & OLED_PROP_RLE) // fill the column from runs
+     {
+        u32Col = 0;
+        for (ty=0; ty<iHeight; ty+=n)
+        {
+           if (iRun == 0)
+           {
+              ucRun = *s++;
+              iRun = (ucRun & 0x7f) + 1;
+           }
+           n = (iRun < iHeight - ty) ? iRun : iHeight - ty;
+           if (ucRun & 0x80)
+              u32Col |= (0xffffffff >> (32 - n)) << ty;
+           iRun -= n;
+        }
+     }
+     else // the next iHeight bits
+     {
+        while (iBits < iHeight)
+        {
+           u64Bits |= (uint64_t)*s++ << iBits;
+           iBits += 8;
+        }
+        u32Col = (uint32_t)u64Bits & u32Mask;
+        u64Bits >>= iHeight;
+        iBits -= iHeight;
+     }
+     if (x < 0)
+        continue;
+     if (bInvert)
+        u32Col = ~u32Col & u32Mask;
+     u64Col = (uint64_t)u32Col << iShift;
+     for (iPage=iPage0; (iPage - iPage0) * 8 < iShift + iHeight; iPage++)
+     {
+        if (iPage < 0 || iPage >= pOLED->oled_y / 8)
+           continue;
+        n = (iPage - iPage0) * 8;
+        ucMask = (uint8_t)(u64Mask >> n);
+        d = &pOLED->ucScreen[(iPage * 128) + x];
+        *d = (*d & ~ucMask) | ((uint8_t)(u64Col >> n) & ucMask);
+     }
+  }
+} /* oledBlitPropGlyph() */
+
+int __oledDrawPropString(SSOLED *pOLED, const uint8_t *pFont, int x, int y, char *szMsg, int bInvert)
+{
+int iStartX = x, iWidth;
+unsigned char c;
+const uint8_t *pEntry;
+
+  if (pOLED->ucScreen == NULL || pFont == NULL || szMsg == NULL)
+     return -1;
+  while ((c = (unsigned char)*szMsg++) != 0)
+  {
+     if (c < pFont[1] || c > pFont[2])
+        continue; // not in the font
+     pEntry = &pFont[OLED_PROP_HEADER + (c - pFont[1]) * OLED_PROP_ENTRY];
+     iWidth = pEntry[0] & 0x7f;
+     if (x < pOLED->oled_x && x + iWidth > 0 && y < pOLED->oled_y && y + pFont[0] > 0)
+        __oledBlitPropGlyph(pOLED, pFont, pEntry, x, y, bInvert);
+     x += iWidth;
+  }
+  if (x > iStartX)
+     __oledSetDirty(pOLED, iStartX, y, x - 1, y + pFont[0] - 1);
+  return x;
+} /* oledDrawPropString() */
+
+int __oledPropStringWidth(const uint8_t *pFont, char *szMsg)
+{
+int iWidth = 0;
+unsigned char c;
+
+  while ((c = (unsigned char)*szMsg++) != 0)
+  {
+     if (c >= pFont[1] && c <= pFont[2])
+        iWidth += pFont[OLED_PROP_HEADER + (c - pFont[1]) * OLED_PROP_ENTRY] & 0x7f;
+  }
+  return iWidth;
+} /* oledPropStringWidth() */
 
 //
 // Render a sprite/rectangle of pixels from a provided buffer to the display.
@@ -1675,12 +2166,23 @@ uint8_t *pSrc = pOLED->ucScreen;
   
   iLines = pOLED->oled_y >> 3;
   iCols = pOLED->oled_x >> 4;
+  if (__oledHoldRAM(pOLED)) // copy into the back buffer, a later flush sends it
+  {
+    if (pSrc != NULL && pBuffer != pSrc)
+      for (y=0; y<iLines; y++)
+      {
+        __oledMarkChanged(pOLED, y * 128, &pBuffer[y * 128], pOLED->oled_x);
+        memcpy(&pSrc[y * 128], &pBuffer[y * 128], pOLED->oled_x);
+      }
+    return;
+  }
   for (y=0; y<iLines; y++)
   {
     bNeedPos = 1; // start of a new line means we need to set the position too
     for (x=0; x<iCols; x++) // wiring library has a 32-byte buffer, so send 16 bytes so that the data prefix (0x40) can fit
     {
-      if (pOLED->ucScreen == NULL || pBuffer == pSrc || memcmp(pSrc, pBuffer, 16) != 0) // doesn't match, need to send it
+      if (pOLED->ucScreen == NULL || pBuffer == pSrc || memcmp(pSrc, pBuffer, 16) != 0 ||
+          (pOLED->ucDirty[y] & (1 << x))) // doesn't match the display, need to send it
       {
         if (bNeedPos) // need to reposition output cursor?
         {
@@ -1699,7 +2201,336 @@ uint8_t *pSrc = pOLED->ucScreen;
     pSrc += (128 - pOLED->oled_x); // for narrow displays, skip to the next line
     pBuffer += (128 - pOLED->oled_x);
   } // for y
+  memset(pOLED->ucDirty, 0, sizeof(pOLED->ucDirty)); // display and back buffer match
 } /* oledDumpBuffer() */
+
+//
+// Send a block of pixel data from the back buffer to the current position
+//
+static void __oledSendData(SSOLED *pOLED, uint8_t *pData, int iLen)
+{
+unsigned char ucTemp[129];
+
+  if (pOLED->pSPI != NULL && pOLED->pu16Stream != NULL)
+  {
+    __oledSPIQueue(pOLED, pData, iLen); // sent by DMA
+    return;
+  }
+  ucTemp[0] = 0x40; // data command
+  memcpy(&ucTemp[1], pData, iLen);
+  _I2CWrite(pOLED, ucTemp, iLen+1);
+} /* oledSendData() */
+
+//
+// Append one I2C transaction (control byte + data) to the DMA stream
+// returns the new number of words in the stream
+//
+static int __oledStreamAppend(SSOLED *pOLED, int iWords, uint8_t ucControl, const uint8_t *pData, int iLen)
+{
+uint16_t *pu16 = &pOLED->pu16Stream[iWords];
+
+  pOLED->u32Bytes += iLen + 2; // + address and control byte
+  *pu16++ = ucControl;
+  while (iLen--)
+    *pu16++ = *pData++;
+  pu16[-1] |= I2CDMA_STOP; // end of the transaction
+  return (int)(pu16 - pOLED->pu16Stream);
+} /* oledStreamAppend() */
+
+//
+// Queue iWords more words: if they do not fit behind the iWords
+// already in the DMA stream, send those first
+// returns the number of words left in the stream
+//
+static int __oledStreamReserve(SSOLED *pOLED, int iWords, int iMore)
+{
+  if (iWords + iMore > pOLED->iStreamLen)
+  {
+    I2CDMATransfer(&pOLED->dma, pOLED->oled_addr, pOLED->pu16Stream, iWords);
+    iWords = 0;
+  }
+  return iWords;
+} /* oledStreamReserve() */
+
+//
+// Send the dirty tiles of a page range as one window in horizontal
+// addressing mode: the position is set once, the data of all pages
+// follows as one transaction (DMA) or one transaction per page
+//
+static int __oledFlushWindow(SSOLED *pOLED, int iWords, int x1, int y1, int x2, int y2)
+{
+int y, iLen = x2 - x1 + 1;
+unsigned char ucCmd[9];
+int iCmd;
+uint16_t *pu16;
+uint8_t *pData;
+
+  ucCmd[0] = 0x00; // command introducer
+  iCmd = __oledWindowCommands(pOLED, x1, y1, x2, y2, &ucCmd[1]);
+  if (pOLED->pu16Stream == NULL || pOLED->pSPI != NULL) // on SPI the pages queue up as one transfer
+  {
+    _I2CWrite(pOLED, ucCmd, iCmd + 1);
+    for (y=y1; y<=y2; y++)
+      __oledSendData(pOLED, &pOLED->ucScreen[(y * 128) + x1], iLen);
+    return 0;
+  }
+  if (y2 > y1 && OLED_STREAM_RUN_WORDS(iLen * (y2 - y1 + 1)) > pOLED->iStreamLen)
+  { // too large for the stream: one page after the other, each on its own
+    for (y=y1; y<=y2; y++)
+      iWords = __oledFlushWindow(pOLED, iWords, x1, y, x2, y);
+    return iWords;
+  }
+  iWords = __oledStreamReserve(pOLED, iWords, OLED_STREAM_RUN_WORDS(iLen * (y2 - y1 + 1)));
+  iWords = __oledStreamAppend(pOLED, iWords, 0x00, &ucCmd[1], iCmd);
+  pu16 = &pOLED->pu16Stream[iWords];
+  *pu16++ = 0x40; // one data transaction for the whole window
+  for (y=y1; y<=y2; y++)
+  {
+    pData = &pOLED->ucScreen[(y * 128) + x1];
+    for (int x=0; x<iLen; x++)
+      *pu16++ = *pData++;
+  }
+  pu16[-1] |= I2CDMA_STOP;
+  pOLED->u32Bytes += iLen * (y2 - y1 + 1) + 2; // + address and control byte
+  return (int)(pu16 - pOLED->pu16Stream);
+} /* oledFlushWindow() */
+
+//
+// Send the dirty tiles of the back buffer
+// Page addressing: runs of adjacent dirty tiles share one position
+// command and one data transfer. Horizontal addressing (SSD1306): the
+// bounding box of the dirty tiles goes out as one window, with its
+// clean tiles. The flush takes the way with fewer bytes on the bus.
+// With a DMA stream the transfers are queued and only the last part
+// is left in progress, otherwise they are sent right away. On SPI the
+// commands are written directly and the data in between is queued.
+//
+static void __oledFlushTiles(SSOLED *pOLED)
+{
+int y, iTile, iStart, iTiles, iLen, iWords = 0;
+int iCmd, iRunBytes, iWindowBytes, iPages;
+int iTrans = (pOLED->pSPI != NULL) ? 0 : 2; // bytes added by each transaction (I2C: address and control byte)
+int x1 = 128, x2 = -1, y1 = -1, y2 = -1;
+uint8_t ucMask = 0;
+uint8_t *pData;
+unsigned char ucCmd[5];
+
+  iTiles = (pOLED->oled_x + 15) >> 4;
+  // the bytes of both ways (each transaction: address + control byte)
+  iRunBytes = 0;
+  for (y=0; y<(pOLED->oled_y >> 3); y++)
+  {
+    if (!pOLED->ucDirty[y])
+      continue;
+    if (y1 < 0) y1 = y;
+    y2 = y;
+    ucMask |= pOLED->ucDirty[y];
+    for (iTile=0; iTile<iTiles; iTile++) // each run: 3 commands + data
+      if ((pOLED->ucDirty[y] & (1 << iTile)) && (iTile == 0 || !(pOLED->ucDirty[y] & (1 << (iTile-1)))))
+        iRunBytes += 3 + 2 * iTrans;
+    for (iTile=0; iTile<iTiles; iTile++)
+      if (pOLED->ucDirty[y] & (1 << iTile))
+        iRunBytes += 16;
+  }
+  if (y1 < 0)
+    return; // nothing to send
+  for (iTile=0; iTile<iTiles; iTile++)
+    if (ucMask & (1 << iTile))
+    {
+      if (iTile * 16 < x1) x1 = iTile * 16;
+      x2 = iTile * 16 + 15;
+    }
+  if (x2 >= pOLED->oled_x) // 72 isn't evenly divisible by 16
+    x2 = pOLED->oled_x - 1;
+  iPages = y2 - y1 + 1;
+  iWindowBytes = 6 + iTrans + (x2 - x1 + 1) * iPages + iTrans * (pOLED->pu16Stream ? 1 : iPages);
+  if (pOLED->ucAddrMode != OLED_ADDR_HORIZONTAL)
+    iWindowBytes += 2;
+  else
+    iRunBytes += 2; // back to page mode
+
+  if (pOLED->pSPI == NULL)
+    I2CLock(&pOLED->bbi2c); // keep the frame together on a shared bus
+  if (pOLED->bWindow && iWindowBytes < iRunBytes)
+  {
+    iWords = __oledFlushWindow(pOLED, iWords, x1, y1, x2, y2);
+    memset(pOLED->ucDirty, 0, sizeof(pOLED->ucDirty));
+  }
+  else for (y=y1; y<=y2; y++)
+  {
+    iTile = 0;
+    while (iTile < iTiles)
+    {
+      if (!(pOLED->ucDirty[y] & (1 << iTile)))
+      {
+        iTile++;
+        continue;
+      }
+      iStart = iTile;
+      while (iTile < iTiles && (pOLED->ucDirty[y] & (1 << iTile)))
+        iTile++;
+      iLen = (iTile - iStart) * 16;
+      if (iTile * 16 > pOLED->oled_x) // 72 isn't evenly divisible by 16
+        iLen -= iTile * 16 - pOLED->oled_x;
+      pData = &pOLED->ucScreen[(y * 128) + (iStart * 16)];
+      if (pOLED->pu16Stream == NULL || pOLED->pSPI != NULL)
+      {
+        __oledSetPosition(pOLED, iStart * 16, y, 1);
+        __oledSendData(pOLED, pData, iLen);
+        continue;
+      }
+      iWords = __oledStreamReserve(pOLED, iWords, OLED_STREAM_RUN_WORDS(iLen));
+      iCmd = __oledPositionCommands(pOLED, iStart * 16, y, ucCmd);
+      iWords = __oledStreamAppend(pOLED, iWords, 0x00, ucCmd, iCmd);
+      iWords = __oledStreamAppend(pOLED, iWords, 0x40, pData, iLen);
+    } // while tiles
+    pOLED->ucDirty[y] = 0;
+  } // for y
+  if (pOLED->pSPI != NULL)
+  {
+    if (pOLED->pu16Stream != NULL)
+      __oledSPIStartQueued(pOLED);
+    return;
+  }
+  if (iWords)
+    I2CDMAStart(&pOLED->dma, pOLED->oled_addr, pOLED->pu16Stream, iWords);
+  I2CUnlock(&pOLED->bbi2c);
+} /* oledFlushTiles() */
+
+int __oledFlushStart(SSOLED *pOLED)
+{
+uint32_t u32Start = pOLED->u32Bytes;
+
+  if (pOLED->ucScreen == NULL)
+    return 0;
+  if (pOLED->ucScrollPages)
+    return 0; // no RAM writes while a scroll runs, the tiles stay dirty
+  __oledFlushWait(pOLED); // the stream is free again
+  __oledFlushTiles(pOLED);
+  if (pOLED->ucFrame) // the display changed within the frame
+    __oledFrameSnapshot(pOLED);
+  return (int)(pOLED->u32Bytes - u32Start);
+} /* oledFlushStart() */
+
+int __oledFlushBusy(SSOLED *pOLED)
+{
+  if (pOLED->pu16Stream == NULL)
+    return 0;
+  if (pOLED->pSPI != NULL)
+    return SPIDMABusy(&pOLED->spidma);
+  return I2CDMABusy(&pOLED->dma);
+} /* oledFlushBusy() */
+
+void __oledFlushWait(SSOLED *pOLED)
+{
+  if (pOLED->pu16Stream == NULL)
+    return;
+  if (pOLED->pSPI != NULL)
+    SPIDMAWait(&pOLED->spidma);
+  else
+    I2CDMAWait(&pOLED->dma);
+} /* oledFlushWait() */
+
+int __oledFlush(SSOLED *pOLED)
+{
+int iBytes;
+
+  iBytes = __oledFlushStart(pOLED);
+  __oledFlushWait(pOLED);
+  return iBytes;
+} /* oledFlush() */
+
+int __oledBeginFrame(SSOLED *pOLED)
+{
+  if (pOLED->ucScreen == NULL)
+    return -1; // a frame is drawn in the back buffer
+  if (pOLED->ucFrame++ == 0)
+    __oledFrameSnapshot(pOLED);
+  return 0;
+} /* oledBeginFrame() */
+
+int __oledEndFrame(SSOLED *pOLED)
+{
+int y, iTile, iTiles, iOffset, iLen;
+uint8_t ucMask;
+
+  if (pOLED->ucFrame == 0)
+    return 0;
+  if (--pOLED->ucFrame) // nested frame: the outermost one flushes
+    return 0;
+  // tiles drawn over with what the display already shows
+  iTiles = (pOLED->oled_x + 15) >> 4;
+  for (y=0; y<(pOLED->oled_y >> 3); y++)
+  {
+    ucMask = pOLED->ucDirty[y] & pOLED->ucFrameClean[y];
+    for (iTile=0; ucMask && iTile<iTiles; iTile++)
+    {
+      if (!(ucMask & (1 << iTile)))
+        continue;
+      iOffset = (y * 128) + (iTile * 16);
+      iLen = pOLED->oled_x - iTile * 16;
+      if (iLen > 16) iLen = 16;
+      if (memcmp(&pOLED->ucScreen[iOffset], &pOLED->pFrameCopy[iOffset], iLen) == 0)
+        pOLED->ucDirty[y] &= ~(1 << iTile);
+    }
+  }
+  return __oledFlushStart(pOLED);
+} /* oledEndFrame() */
+
+int __oledSetDMAStream(SSOLED *pOLED, uint16_t *pStream, int iLen)
+{
+  if (pOLED->pu16Stream != NULL) // release the current one
+  {
+    __oledFlushWait(pOLED);
+    if (pOLED->pSPI != NULL)
+      SPIDMAFree(&pOLED->spidma);
+    else
+      I2CDMAFree(&pOLED->dma);
+    pOLED->pu16Stream = NULL;
+  }
+  if (pStream == NULL)
+    return 0;
+  if (iLen < OLED_STREAM_RUN_WORDS(128))
+    return -1;
+  if (pOLED->pSPI != NULL ? SPIDMAInit(&pOLED->spidma, pOLED->pSPI, pOLED->iCSPin) != 0
+                          : I2CDMAInit(&pOLED->dma, &pOLED->bbi2c) != 0)
+    return -1;
+  pOLED->pu16Stream = pStream;
+  pOLED->iStreamLen = iLen;
+  return 0;
+} /* oledSetDMAStream() */
+
+//
+// Mark a rectangle of the back buffer as changed
+//
+void __oledSetDirty(SSOLED *pOLED, int x1, int y1, int x2, int y2)
+{
+int y, tmp;
+uint8_t ucMask;
+
+  if (x2 < x1)
+  {
+    tmp = x1; x1 = x2; x2 = tmp;
+  }
+  if (y2 < y1)
+  {
+    tmp = y1; y1 = y2; y2 = tmp;
+  }
+  if (x2 < 0 || y2 < 0 || x1 >= pOLED->oled_x || y1 >= pOLED->oled_y)
+    return; // off the screen
+  if (x1 < 0) x1 = 0;
+  if (y1 < 0) y1 = 0;
+  if (x2 >= pOLED->oled_x) x2 = pOLED->oled_x - 1;
+  if (y2 >= pOLED->oled_y) y2 = pOLED->oled_y - 1;
+  ucMask = (0xff << (x1 >> 4)) & (0xff >> (7 - (x2 >> 4)));
+  for (y=(y1 >> 3); y<=(y2 >> 3); y++)
+    pOLED->ucDirty[y] |= ucMask;
+} /* oledSetDirty() */
+
+uint32_t __oledGetByteCount(SSOLED *pOLED)
+{
+  return pOLED->u32Bytes;
+} /* oledGetByteCount() */
 //
 // Fill the frame buffer with a byte pattern
 // e.g. all off (0x00) or all on (0xff)
@@ -1714,6 +2545,8 @@ unsigned char temp[16];
   iCols = pOLED->oled_x >> 4;
   memset(temp, ucData, 16);
   pOLED->iCursorX = pOLED->iCursorY = 0;
+  if (__oledHoldRAM(pOLED))
+    bRender = 0;
  
   for (y=0; y<iLines; y++)
   {
@@ -1728,6 +2561,8 @@ unsigned char temp[16];
   } // for y
   if (pOLED->ucScreen)
     memset(pOLED->ucScreen, ucData, (pOLED->oled_x * pOLED->oled_y)/8);
+  if (bRender) // the whole display has been written
+    memset(pOLED->ucDirty, 0, sizeof(pOLED->ucDirty));
 } /* oledFill() */
 
 //
@@ -1740,8 +2575,22 @@ unsigned char temp[16];
 void __oledSetBackBuffer(SSOLED *pOLED, uint8_t *pBuffer)
 {
   pOLED->ucScreen = pBuffer;
+  // nothing is known about the display contents yet
+  memset(pOLED->ucDirty, (pBuffer) ? 0xff : 0, sizeof(pOLED->ucDirty));
+  memset(pOLED->ucFrameClean, 0, sizeof(pOLED->ucFrameClean));
 } /* oledSetBackBuffer() */
 
+//
+// Provide or revoke the frame copy, a buffer of the back buffer's size
+// that oledBeginFrame() copies the tiles matching the display into
+//
+void __oledSetFrameCopy(SSOLED *pOLED, uint8_t *pBuffer)
+{
+  pOLED->pFrameCopy = pBuffer;
+  // takes effect with the next frame
+  memset(pOLED->ucFrameClean, 0, sizeof(pOLED->ucFrameClean));
+} /* oledSetFrameCopy() */
+
 void __oledDrawLine(SSOLED *pOLED, int x1, int y1, int x2, int y2, int bRender)
 {
   int temp;
@@ -1754,6 +2603,10 @@ void __oledDrawLine(SSOLED *pOLED, int x1, int y1, int x2, int y2, int bRender)
   
   if (x1 < 0 || x2 < 0 || y1 < 0 || y2 < 0 || x1 >= pOLED->oled_x || x2 >= pOLED->oled_x || y1 >= pOLED->oled_y || y2 >= pOLED->oled_y)
      return;
+  if (__oledHoldRAM(pOLED))
+     bRender = 0;
+  if (!bRender) // pixels are set in the back buffer before they are written
+     __oledSetDirty(pOLED, x1, y1, x2, y2);
 
   if(abs(dx) > abs(dy)) {
     // X major case
@@ -1957,6 +2810,7 @@ void __oledEllipse(SSOLED *pOLED, int iCenterX, int iCenterY, int32_t iRadiusX,
     if (pOLED == NULL || pOLED->ucScreen == NULL)
         return; // must have back buffer defined
     if (iRadiusX <= 0 || iRadiusY <= 0) return; // invalid radii
+    __oledSetDirty(pOLED, iCenterX - iRadiusX, iCenterY - iRadiusY, iCenterX + iRadiusX, iCenterY + iRadiusY);
     
     if (iRadiusX > iRadiusY) // use X as the primary radius
     {
@@ -2012,6 +2866,7 @@ void __oledRectangle(SSOLED *pOLED, int x1, int y1, int x2, int y2, uint8_t ucCo
         y1 = y2;
         y2 = tmp;
     }
+    __oledSetDirty(pOLED, x1, y1, x2, y2);
     if (bFilled)
     {
         int x, y, iMiddle;
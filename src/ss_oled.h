@@ -2,6 +2,31 @@
 #define __SS_OLED_H__
 
 #include "BitBang_I2C.h"
+#include "i2c_dma.h"
+#include "spi_dma.h"
+
+// characters 32..127 of the fonts can be cached
+#define OLED_GLYPH_CHARS 96
+// width in columns of the characters of a fixed font size
+#define OLED_FONT_WIDTH(iSize) ((iSize) == FONT_6x8 ? 6 : (iSize) == FONT_8x8 ? 8 : \
+                                (iSize) == FONT_12x16 ? 12 : 16)
+// bytes of one glyph of a font size in a glyph cache
+#define OLED_GLYPH_BYTES(iSize) ((iSize) == FONT_6x8 ? 6 : (iSize) == FONT_8x8 ? 8 : \
+                                 (iSize) == FONT_12x16 ? 24 : (iSize) == FONT_16x16 ? 32 : 64)
+
+typedef struct oledglyphs
+{
+uint8_t *pGlyphs; // iSlots glyphs of iBytes each, as sent to the display, page by page
+struct oledglyphs *pNext; // next cache attached to the same display
+uint8_t iSize, bInvert, iBytes;
+uint8_t iSlots; // number of glyphs the buffer holds
+uint8_t iUsed; // slots filled so far
+uint8_t iPinned; // slots 0..iPinned-1 hold the preloaded characters and are never replaced
+uint8_t iNext; // slot replaced on the next miss once all are used
+uint8_t ucSlot[OLED_GLYPH_CHARS]; // per character: its slot + 1, 0 = not cached
+uint8_t ucChar[OLED_GLYPH_CHARS]; // per slot: its character - 32
+uint32_t u32Hits, u32Misses;
+} OLEDGLYPHS;
 
 typedef struct ssoleds
 {
@@ -12,7 +37,37 @@ uint8_t iCursorX, iCursorY;
 uint8_t oled_x, oled_y;
 int iScreenOffset;
 BBI2C bbi2c;
+uint8_t ucDirty[16]; // per page: bit n set = columns 16n..16n+15 of the back buffer not yet on the display
+uint32_t u32Bytes; // bytes written to the display (I2C address and control bytes included)
+uint16_t *pu16Stream; // DMA stream of the flush (NULL = blocking writes)
+int iStreamLen; // its length in words
+I2CDMA dma;
+uint8_t ucAddrMode; // memory addressing mode of the controller (OLED_ADDR_xxx)
+uint8_t bWindow; // controller can flush a window in horizontal addressing mode (SSD1306)
+uint8_t ucFrame; // nesting depth of oledBeginFrame()
+uint8_t ucFrameClean[16]; // per page: tiles that matched the display when the frame began
+uint8_t *pFrameCopy; // their contents then, laid out like the back buffer (NULL = none)
+OLEDGLYPHS *pGlyphCache; // attached glyph caches
+uint8_t ucStartLine; // display start line (RAM row shown at the top)
+uint8_t ucScrollPages; // bit n set = page n was moved by a hardware scroll
+spi_inst_t *pSPI; // SPI unit of a 4-wire SPI display (NULL = I2C)
+int8_t iSCKPin, iMOSIPin, iCSPin, iDCPin, iResetPin; // SPI pins (-1 = CS or reset not connected)
+SPIDMA spidma; // SPI: DMA of the flush data
+int iSPIQueued; // SPI: bytes of display data in the stream, not yet started
 } SSOLED;
+
+// memory addressing modes (command 0x20)
+enum {
+  OLED_ADDR_HORIZONTAL = 0,
+  OLED_ADDR_VERTICAL,
+  OLED_ADDR_PAGE
+};
+
+// DMA stream words of one transfer of a flush: up to 8 position or window
+// commands + iLen data bytes, with their control bytes
+#define OLED_STREAM_RUN_WORDS(iLen) (1 + 8 + 1 + (iLen))
+// stream length that holds a whole frame of a display with the given height
+#define OLED_STREAM_LEN(iHeight) (((iHeight) / 8) * OLED_STREAM_RUN_WORDS(128))
 // Make the Linux library interface C instead of C++
 #if defined(__cplusplus)
 extern "C" {
@@ -60,7 +115,10 @@ enum {
   OLED_SH1106_3C,   // SH1106 found at 0x3C
   OLED_SH1106_3D,   // SH1106 found at 0x3D
   OLED_SH1107_3C,  // SH1107
-  OLED_SH1107_3D
+  OLED_SH1107_3D,
+  OLED_SSD1306_SPI, // on SPI the controller follows from the display type
+  OLED_SH1106_SPI,
+  OLED_SH1107_SPI
 };
 //
 // Initializes the OLED controller into "page mode" on I2C
@@ -68,6 +126,13 @@ enum {
 // Otherwise use the Wire library.
 // If you don't need to use a separate reset pin, set it to -1
 //
+// With pSPI set the display is driven by 4-wire SPI instead: iSpeed is
+// the SPI clock, the D/C pin selects commands (low) or display data (high),
+// a reset pin (iResetPin >= 0) is pulsed first. A display cannot be
+// detected on SPI; the controller follows from oled_type (OLED_132x64:
+// SH1106, OLED_128x128: SH1107, else SSD1306) and is returned as
+// OLED_xxx_SPI. Reading the display RAM is not possible.
+//
 int __oledInit(SSOLED *pOLED, int bInvert, int32_t iSpeed);
 
 //
@@ -79,6 +144,13 @@ int __oledInit(SSOLED *pOLED, int bInvert, int32_t iSpeed);
 //
 void __oledSetBackBuffer(SSOLED *pOLED, uint8_t *pBuffer);
 
+//
+// Provide or revoke (NULL) the frame copy of oledBeginFrame(), a buffer
+// of the same size as the back buffer. Without it a frame sends every
+// tile written to, even if it ends up unchanged
+//
+void __oledSetFrameCopy(SSOLED *pOLED, uint8_t *pBuffer);
+
 //
 // Sets the brightness (0=off, 255=brightest)
 //
@@ -125,6 +197,91 @@ void __oledSetTextWrap(SSOLED *pOLED, int bWrap);
 //
 int __oledWriteString(SSOLED *pOLED, int iScrollX, int x, int y, char *szMsg, int iSize, int bInvert, int bRender);
 
+//
+// Glyph cache: oledWriteString() copies the glyphs of a font size and
+// color (bInvert) from an attached cache, where they are kept stretched
+// and inverted as they are sent, instead of preparing them for each
+// character. A buffer of n * OLED_GLYPH_BYTES(iSize) bytes holds n glyphs.
+// Glyphs are added on first use, replacing others in turn once the cache
+// is full, except those of a declared character set expanded with
+// oledGlyphCachePreload() right after oledGlyphCacheInit().
+// Attach caches after oledInit(), which detaches all of them.
+//
+// oledGlyphCacheInit() returns the number of glyphs the buffer holds or
+// -1 for invalid parameters, oledGlyphCachePreload() 0 for success or -1
+// if not all characters of szChars fit
+//
+int __oledGlyphCacheInit(OLEDGLYPHS *pCache, int iSize, int bInvert, uint8_t *pBuffer, int iLen);
+int __oledGlyphCachePreload(OLEDGLYPHS *pCache, char *szChars);
+void __oledAddGlyphCache(SSOLED *pOLED, OLEDGLYPHS *pCache);
+void __oledRemoveGlyphCache(SSOLED *pOLED, OLEDGLYPHS *pCache);
+
+//
+// Proportional fonts, made from BDF files with host/bdf2font and kept
+// in flash as const byte arrays:
+// byte 0: height in pixels (1..32), 1: first character, 2: last character,
+// 3: ascent (rows above the baseline),
+// then 3 bytes per character: advance width in columns (bits 0..6,
+// bit 7 set = run-length coded) and the offset of its columns behind this
+// table (LSB first),
+// then the columns, left to right, each top to bottom: either bit-packed
+// (LSB first, continuing across columns) or as runs of one byte each
+// (bit 7 = the pixel, bits 0..6 = length - 1)
+//
+#define OLED_PROP_HEADER 4
+#define OLED_PROP_ENTRY 3
+#define OLED_PROP_RLE 0x80
+//
+// Draw a string in a proportional font into the back buffer with its top
+// left corner at pixel x,y (not limited to text rows); each glyph covers
+// its whole cell, so new text replaces what was there. Characters outside
+// the range of the font are skipped. Send it with oledFlush().
+// Returns the x position after the string, -1 without a back buffer
+//
+int __oledDrawPropString(SSOLED *pOLED, const uint8_t *pFont, int x, int y, char *szMsg, int bInvert);
+//
+// Width of a string in a proportional font in pixels
+//
+int __oledPropStringWidth(const uint8_t *pFont, char *szMsg);
+
+//
+// Hardware scrolling (SSD1306 only, -1 on the SH1106/SH1107): the
+// controller moves pages iStartPage..iEndPage by one column every
+// iFrames frames (2, 3, 4, 5, 25, 64, 128 or 256) on its own, the
+// diagonal directions also move the vertical scroll area (see
+// oledSetScrollArea()) up by iVertical rows (1..63) per step.
+// The SSD1306 takes no display RAM writes at all while a scroll runs,
+// so until oledScrollStop() drawing calls change the back buffer only
+// (whatever their bRender argument; without a back buffer they are
+// lost) and oledFlush()/oledEndFrame() send nothing, the dirty tiles
+// wait. A horizontal scroll moves the display RAM itself:
+// oledScrollStop() marks the scrolled pages as changed, so the next
+// oledFlush() shows the back buffer again.
+// oledScrollStart() returns 0 for success, -1 for invalid parameters
+//
+enum {
+  OLED_SCROLL_RIGHT = 0,
+  OLED_SCROLL_LEFT,
+  OLED_SCROLL_UP_RIGHT, // vertical and horizontal
+  OLED_SCROLL_UP_LEFT
+};
+int __oledScrollStart(SSOLED *pOLED, int iDir, int iStartPage, int iEndPage, int iFrames, int iVertical);
+void __oledScrollStop(SSOLED *pOLED);
+//
+// Rows iTop..iTop+iRows-1 move with a diagonal scroll, the others stay
+// Returns 0 for success, -1 for invalid parameters
+//
+int __oledSetScrollArea(SSOLED *pOLED, int iTop, int iRows);
+//
+// Show RAM row iLine (0..63, SH1107 0..127) at the top of the display:
+// a vertical scroll in steps of the caller, one command byte each, that
+// doesn't touch the display RAM. Row y of the back buffer then appears at
+// (y - iLine) modulo the RAM height; a ticker moves the start line by 8
+// and draws its new line into the page that wrapped to the bottom.
+// Returns 0 for success, -1 for an invalid line
+//
+int __oledSetStartLine(SSOLED *pOLED, int iLine);
+
 //
 // Fill the frame buffer with a byte pattern
 // e.g. all off (0x00) or all on (0xff)
@@ -147,6 +304,75 @@ int __oledSetPixel(SSOLED *pOLED, int x, int y, unsigned char ucColor, int bRend
 //
 void __oledDumpBuffer(SSOLED *pOLED, uint8_t *pBuffer);
 
+//
+// Send the parts of the back buffer that changed since they were last
+// sent to the display. The back buffer is tracked in tiles of 16 columns
+// by 8 rows; adjacent dirty tiles of a page go out as one transfer, or,
+// on an SSD1306 if that takes fewer bytes, the box around all dirty
+// tiles as one window in horizontal addressing mode.
+// Draw with bRender=0 and call this once per frame.
+// Returns the number of bytes written to the display
+//
+int __oledFlush(SSOLED *pOLED);
+
+//
+// Let the flush feed the I2C unit by DMA from a stream of iLen words
+// (see i2c_dma.h) instead of blocking writes; OLED_STREAM_LEN(height)
+// words take a whole frame, at least OLED_STREAM_RUN_WORDS(128) are needed.
+// On SPI the stream holds the display data of the flush as bytes (two per
+// word), sent by DMA (see spi_dma.h) while the commands are written directly.
+// The stream is a copy, so the back buffer may change while it is sent.
+// Pass NULL to go back to blocking writes.
+// returns 0 for success, -1 if the stream is too short or no DMA channel is free
+//
+int __oledSetDMAStream(SSOLED *pOLED, uint16_t *pStream, int iLen);
+
+//
+// Start a flush and return while the last part of it is still sent
+// by DMA; without a DMA stream this is oledFlush()
+// Other transactions on the bus wait until it has completed.
+// Returns the number of bytes queued for the display
+//
+int __oledFlushStart(SSOLED *pOLED);
+//
+// Returns 1 while a flush is in progress
+//
+int __oledFlushBusy(SSOLED *pOLED);
+//
+// Wait (WFE) until the flush has completed
+//
+void __oledFlushWait(SSOLED *pOLED);
+
+//
+// Frame transaction: between oledBeginFrame() and oledEndFrame() all
+// drawing calls (with any bRender value) change the back buffer only,
+// oledEndFrame() sends what changed with one flush (oledFlushStart(),
+// so with a DMA stream it returns while the data is sent).
+// Frames may nest, the outermost oledEndFrame() flushes.
+// With a frame copy (oledSetFrameCopy()) a frame compares against the
+// display, not against the back buffer of the moment: oledBeginFrame()
+// copies every tile that matches the display, and oledEndFrame() sends
+// none of these whose bytes end up the same, so fill() and a full
+// redraw cost only the tiles that really changed. A flush inside the
+// frame takes a new copy; a back buffer set or a scroll stopped inside
+// the frame leaves the affected tiles to be sent.
+// oledBeginFrame() returns -1 without a back buffer,
+// oledEndFrame() the number of bytes queued for the display
+//
+int __oledBeginFrame(SSOLED *pOLED);
+int __oledEndFrame(SSOLED *pOLED);
+
+//
+// Mark a rectangle of the back buffer (pixel coordinates) as changed,
+// e.g. after writing to the buffer directly
+//
+void __oledSetDirty(SSOLED *pOLED, int x1, int y1, int x2, int y2);
+
+//
+// Number of bytes written to the display since oledInit()
+//
+uint32_t __oledGetByteCount(SSOLED *pOLED);
+
 //
 // Render a window of pixels from a provided buffer or the library's internal buffer
 // to the display. The row values refer to byte rows, not pixel rows due to the memory
@@ -1,8 +1,10 @@
 #pragma once
+#include <string.h>
 #include "BitBang_I2C.h"
 #include "ss_oled.h"
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/spi.h"
 
 class picoSSOLED {
 	
@@ -17,6 +19,7 @@ public:
 //constructor
 
 	picoSSOLED(int iType, int iAddr, bool bFlip, bool bInvert, i2c_inst_t * pI2C, int sda, int scl, int32_t iSpeed) {
+		memset(&oled, 0, sizeof(oled)) ; // I2CInit() initialises the bus lock once, also on the stack
 		oled.oled_type = iType ;
 		oled.oled_addr = iAddr ;
 		oled.oled_flip = (int) bFlip ;
@@ -25,6 +28,30 @@ public:
     	oled.bbi2c.iSDA = sda ;
     	oled.bbi2c.iSCL = scl ;
 		speed = iSpeed ;
+		oled.pu16Stream = NULL ;
+	};
+
+//
+// A display on 4-wire SPI: clock and data pins of the SPI unit, chip
+// select, data/command and reset pin (cs and reset may be -1 if not
+// connected), iSpeed is the SPI clock (SSD1306: up to 10 MHz).
+// init() returns OLED_SSD1306_SPI, OLED_SH1106_SPI or OLED_SH1107_SPI
+// depending on iType. With set_dma_stream() the display data of a
+// flush is sent by DMA.
+//
+	picoSSOLED(int iType, bool bFlip, bool bInvert, spi_inst_t * pSPI, int sck, int mosi, int cs, int dc, int reset, int32_t iSpeed) {
+		memset(&oled, 0, sizeof(oled)) ;
+		oled.oled_type = iType ;
+		oled.oled_flip = (int) bFlip ;
+		invert = bInvert ;
+		oled.pSPI = pSPI ;
+		oled.iSCKPin = sck ;
+		oled.iMOSIPin = mosi ;
+		oled.iCSPin = cs ;
+		oled.iDCPin = dc ;
+		oled.iResetPin = reset ;
+		speed = iSpeed ;
+		oled.pu16Stream = NULL ;
 	};
 
 	
@@ -32,6 +59,14 @@ public:
 		return __oledInit(&oled, (int) invert, (int32_t) speed);
 	};
 
+//
+// The I2C bus of the display, for other devices on the same bus
+// (e.g. a BME280 built with BME280_USE_I2C); not used by SPI displays
+//
+	BBI2C * get_bus() {
+		return &oled.bbi2c;
+	};
+
 
 //
 // Provide or revoke a back buffer for your OLED graphics
@@ -44,6 +79,15 @@ public:
 		__oledSetBackBuffer(&oled, pBuffer);
 	};
 
+//
+// Provide or revoke (NULL) a buffer of the back buffer's size in which
+// begin_frame() keeps the tiles the display shows; end_frame() then
+// sends only tiles whose bytes really changed (see below)
+//
+	void set_frame_copy(uint8_t * pBuffer) {
+		__oledSetFrameCopy(&oled, pBuffer);
+	};
+
 //
 // Sets the brightness (0=off, 255=brightest)
 //
@@ -102,6 +146,42 @@ public:
 		return __oledWriteString(&oled, iScrollX, x, y, szMsg, iSize, (int) bInvert, (int) bRender);
 	};
 
+//
+// Keep the glyphs of a font size and color ready in pBuffer
+// (n * OLED_GLYPH_BYTES(iSize) bytes hold n glyphs), so write_string()
+// copies them instead of stretching and inverting each character.
+// The characters of szPreload are expanded now and stay, others are
+// added on first use. Call after init().
+// Returns the number of glyphs the cache holds, -1 for invalid parameters
+//
+	int add_glyph_cache(OLEDGLYPHS *pCache, int iSize, bool bInvert, uint8_t *pBuffer, int iLen, char *szPreload = NULL) {
+		int rc = __oledGlyphCacheInit(pCache, iSize, (int) bInvert, pBuffer, iLen);
+		if (rc < 0)
+			return rc;
+		if (szPreload != NULL)
+			__oledGlyphCachePreload(pCache, szPreload);
+		__oledAddGlyphCache(&oled, pCache);
+		return rc;
+	};
+
+	void remove_glyph_cache(OLEDGLYPHS *pCache) {
+		__oledRemoveGlyphCache(&oled, pCache);
+	};
+
+//
+// Draw a string in a proportional font (converted with host/bdf2font,
+// e.g. font_small_prop.h) into the back buffer, top left corner at
+// pixel x,y; send it with flush() or end_frame()
+// Returns the x position after the string, -1 without a back buffer
+//
+	int draw_string(int x, int y, char *szMsg, const uint8_t *pFont, bool bInvert) {
+		return __oledDrawPropString(&oled, pFont, x, y, szMsg, (int) bInvert);
+	};
+
+	static int string_width(char *szMsg, const uint8_t *pFont) {
+		return __oledPropStringWidth(pFont, szMsg);
+	};
+
 //
 // Fill the frame buffer with a byte pattern
 // e.g. all off (0x00) or all on (0xff)
@@ -130,6 +210,78 @@ public:
 		__oledDumpBuffer(&oled, pBuffer);
 	};
 
+//
+// Send the parts of the back buffer that changed since they were last
+// sent to the display. The back buffer is tracked in tiles of 16 columns
+// by 8 rows; adjacent dirty tiles of a page go out as one transfer.
+// Draw with bRender=false and call this once per frame.
+// Returns the number of bytes written to the display
+//
+	int flush() {
+		return __oledFlush(&oled);
+	};
+
+//
+// Send flushes by DMA from a stream of iLen words (OLED_STREAM_LEN(height)
+// for a whole frame, see ss_oled.h; on SPI it holds the display data
+// only); NULL returns to blocking writes
+// Returns false if the stream is too short or no DMA channel is free
+//
+	bool set_dma_stream(uint16_t *pStream, int iLen) {
+		return __oledSetDMAStream(&oled, pStream, iLen) == 0;
+	};
+
+//
+// Start a flush and return while the DMA sends it; the back buffer
+// may be drawn again right away. Other transactions on the bus wait
+// until the flush has completed.
+//
+	int flush_start() {
+		return __oledFlushStart(&oled);
+	};
+
+	bool flush_busy() {
+		return __oledFlushBusy(&oled) != 0;
+	};
+
+	void flush_wait() {
+		__oledFlushWait(&oled);
+	};
+
+//
+// Frame transaction: between begin_frame() and end_frame() all drawing
+// calls change the back buffer only, whatever their bRender argument;
+// end_frame() sends what changed with one flush_start(). Avoids the
+// flicker of clearing and redrawing the panel and many small transfers.
+// With a frame copy (set_frame_copy()) "changed" means against the
+// display when the frame began: tiles that are overwritten and then
+// redrawn with the same bytes are not sent.
+// begin_frame() returns false without a back buffer,
+// end_frame() the number of bytes queued for the display
+//
+	bool begin_frame() {
+		return __oledBeginFrame(&oled) == 0;
+	};
+
+	int end_frame() {
+		return __oledEndFrame(&oled);
+	};
+
+//
+// Mark a rectangle of the back buffer (pixel coordinates) as changed,
+// e.g. after writing to the buffer directly
+//
+	void set_dirty(int x1, int y1, int x2, int y2) {
+		__oledSetDirty(&oled, x1, y1, x2, y2);
+	};
+
+//
+// Number of bytes written to the display since init()
+//
+	uint32_t get_byte_count() {
+		return __oledGetByteCount(&oled);
+	};
+
 //
 // Render a window of pixels from a provided buffer or the library's internal buffer
 // to the display. The row values refer to byte rows, not pixel rows due to the memory
@@ -168,6 +320,41 @@ public:
 		return __oledScrollBuffer(&oled, iStartCol,iEndCol, iStartRow, iEndRow, (int) bUp);
 	};
 
+//
+// Hardware scrolling of the SSD1306 (see ss_oled.h): pages iStartPage to
+// iEndPage move by one column every iFrames frames (2, 3, 4, 5, 25, 64,
+// 128 or 256) without further bus traffic; OLED_SCROLL_UP_RIGHT/LEFT
+// also move the scroll area up by iVertical rows per step.
+// Until scroll_stop() the display RAM must not be written: drawing goes
+// to the back buffer only and flush()/end_frame() send nothing. The
+// first flush() after scroll_stop() sends the changes and restores the
+// scrolled pages.
+// Returns false for invalid parameters or a controller without scrolling
+//
+	bool scroll_start(int iDir, int iStartPage, int iEndPage, int iFrames, int iVertical = 0) {
+		return __oledScrollStart(&oled, iDir, iStartPage, iEndPage, iFrames, iVertical) == 0;
+	};
+
+	void scroll_stop() {
+		__oledScrollStop(&oled);
+	};
+
+	bool set_scroll_area(int iTop, int iRows) {
+		return __oledSetScrollArea(&oled, iTop, iRows) == 0;
+	};
+
+//
+// Show RAM row iLine at the top of the display: a vertical scroll for
+// one command byte, the display RAM and back buffer stay as they are
+//
+	bool set_start_line(int iLine) {
+		return __oledSetStartLine(&oled, iLine) == 0;
+	};
+
+	int get_start_line() {
+		return oled.ucStartLine;
+	};
+
 //
 // Draw a sprite of any size in any position
 // If it goes beyond the left/right or top/bottom edges